@@ -24,6 +24,54 @@ struct ComponentFour
     int x;
 };
 
+struct Frozen
+{
+};
+
+// Same layout as ComponentOne..Four, stored in archetype tables
+template <int N>
+struct TableComponent
+{
+    int x;
+};
+
+template <int N>
+struct FECS::ComponentTraits<TableComponent<N>> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::TABLE;
+};
+
+// Same layout, once stored as an array of structs and once as one array per field
+struct Body
+{
+    float x, y, z, w;
+};
+
+struct SoABody
+{
+    float x, y, z, w;
+};
+
+template <>
+struct FECS::ComponentTraits<SoABody> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::SOA;
+    static constexpr auto fields = std::make_tuple(&SoABody::x, &SoABody::y, &SoABody::z, &SoABody::w);
+};
+
+// Same component, with and without presence bitmaps
+template <int N, bool PRESENCE>
+struct JoinComponent
+{
+    int x;
+};
+
+template <int N, bool PRESENCE>
+struct FECS::ComponentTraits<JoinComponent<N, PRESENCE>> : FECS::DefaultComponentTraits
+{
+    static constexpr bool presenceBitmap = PRESENCE;
+};
+
 #define NUM_ENTITIES 100
 
 
@@ -127,6 +175,134 @@ auto Benchmark_QueryFourComponents(FECS::World& world) -> void
     });
 }
 
+auto Benchmark_ParallelQueryFourComponents(FECS::World& world) -> void
+{
+    Benchmark bm("Parallel query 4 components");
+    world.View()
+        .Query<ComponentOne, ComponentTwo, ComponentThree, ComponentFour>()
+        .ParallelEach([](FECS::Entity id,
+                         ComponentOne& one,
+                         ComponentTwo& two,
+                         ComponentThree& three,
+                         ComponentFour& four)
+    {
+        one.x++;
+        two.x++;
+        three.x++;
+        four.x++;
+    });
+}
+
+auto Benchmark_CachedQueryFourComponents(FECS::World& world) -> void
+{
+    auto& query = world.View().Cached<ComponentOne, ComponentTwo, ComponentThree, ComponentFour>();
+    query.Refresh();
+
+    Benchmark bm("Cached query 4 components");
+    query.Each([](FECS::Entity id,
+                  ComponentOne& one,
+                  ComponentTwo& two,
+                  ComponentThree& three,
+                  ComponentFour& four)
+    {
+        one.x++;
+        two.x++;
+        three.x++;
+        four.x++;
+    });
+}
+
+auto Benchmark_GroupFourComponents(FECS::World& world) -> void
+{
+    auto group = world.View().Group<ComponentOne, ComponentTwo, ComponentThree, ComponentFour>();
+
+    Benchmark bm("Group 4 components");
+    group.Each([](FECS::Entity id,
+                  ComponentOne& one,
+                  ComponentTwo& two,
+                  ComponentThree& three,
+                  ComponentFour& four)
+    {
+        one.x++;
+        two.x++;
+        three.x++;
+        four.x++;
+    });
+}
+
+auto Benchmark_TableQueryFourComponents(FECS::World& world) -> void
+{
+    Benchmark bm("Table query 4 components");
+    world.View()
+        .Query<TableComponent<1>, TableComponent<2>, TableComponent<3>, TableComponent<4>>()
+        .Each([](FECS::Entity id,
+                 TableComponent<1>& one,
+                 TableComponent<2>& two,
+                 TableComponent<3>& three,
+                 TableComponent<4>& four)
+    {
+        one.x++;
+        two.x++;
+        three.x++;
+        four.x++;
+    });
+}
+
+auto Benchmark_TableChunkedQueryFourComponents(FECS::World& world) -> void
+{
+    Benchmark bm("Table chunked query 4 components");
+    world.View()
+        .Query<TableComponent<1>, TableComponent<2>, TableComponent<3>, TableComponent<4>>()
+        .EachChunk([](std::size_t count,
+                      const FECS::Entity* ids,
+                      TableComponent<1>* one,
+                      TableComponent<2>* two,
+                      TableComponent<3>* three,
+                      TableComponent<4>* four)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            one[i].x++;
+            two[i].x++;
+            three[i].x++;
+            four[i].x++;
+        }
+    });
+}
+
+auto Benchmark_LambdaFilteredQuery(FECS::World& world) -> void
+{
+    Benchmark bm("Query 2 components, filtered in lambda");
+    auto& components = world.Components();
+    world.View()
+        .Query<ComponentOne, ComponentTwo>()
+        .Each([&components](FECS::Entity id,
+                            ComponentOne& one,
+                            ComponentTwo& two)
+    {
+        if (components.Has<Frozen>(id))
+        {
+            return;
+        }
+        one.x++;
+        two.x++;
+    });
+}
+
+auto Benchmark_WithoutQuery(FECS::World& world) -> void
+{
+    Benchmark bm("Query 2 components, Without<Frozen>");
+    world.View()
+        .Query<ComponentOne, ComponentTwo, FECS::Without<Frozen>>()
+        .Each([](FECS::Entity id,
+                 ComponentOne& one,
+                 ComponentTwo& two)
+    {
+        one.x++;
+        two.x++;
+    });
+}
+
 // Times: Get (4 Components)with the fast_vector.h
 // 100 Entities
 // 10,000 Entities
@@ -143,6 +319,192 @@ auto Benchmark_GetFourComponents(FECS::World& world, std::vector<FECS::Entity>&
     }
 }
 
+// Same lookups through pool handles resolved once up front
+auto Benchmark_GetFourComponentsPooled(FECS::World& world, std::vector<FECS::Entity>& ids) -> void
+{
+    FECS::Pool<ComponentOne> one = world.Components().Pool<ComponentOne>();
+    FECS::Pool<ComponentTwo> two = world.Components().Pool<ComponentTwo>();
+    FECS::Pool<ComponentThree> three = world.Components().Pool<ComponentThree>();
+    FECS::Pool<ComponentFour> four = world.Components().Pool<ComponentFour>();
+
+    Benchmark bm("Get 4 components (pool handles)");
+    for (int i = 0; i < NUM_ENTITIES; i++)
+    {
+        one.Get(ids[i]);
+        two.Get(ids[i]);
+        three.Get(ids[i]);
+        four.Get(ids[i]);
+    }
+}
+
+// Fills a world with count entities owning the four components, returning half of them
+auto PopulateForDestruction(FECS::World& world, int count) -> std::vector<FECS::Entity>
+{
+    std::vector<FECS::Entity> doomed;
+    for (int i = 0; i < count; i++)
+    {
+        FECS::Entity id = world.Entities().Create().Build();
+        world.Components().Attach<ComponentOne>(id, {i});
+        world.Components().Attach<ComponentTwo>(id, {i});
+        world.Components().Attach<ComponentThree>(id, {i});
+        world.Components().Attach<ComponentFour>(id, {i});
+        if (i % 2 == 0)
+        {
+            doomed.push_back(id);
+        }
+    }
+    return doomed;
+}
+
+auto Benchmark_DeleteLoop(int count, const char* label) -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> doomed = PopulateForDestruction(world, count);
+
+    Benchmark bm(label);
+    for (FECS::Entity id : doomed)
+    {
+        world.Entities().Delete(id);
+    }
+}
+
+auto Benchmark_DestroyBatch(int count, const char* label) -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> doomed = PopulateForDestruction(world, count);
+
+    Benchmark bm(label);
+    world.Entities().DestroyBatch(doomed);
+}
+
+auto Benchmark_CreateLoop(int count, const char* label) -> void
+{
+    FECS::World world;
+
+    Benchmark bm(label);
+    for (int i = 0; i < count; i++)
+    {
+        world.Entities()
+            .Create()
+            .Attach<ComponentOne>({i})
+            .Attach<ComponentTwo>({i})
+            .Attach<ComponentThree>({i})
+            .Build();
+    }
+}
+
+auto Benchmark_Spawn(int count, const char* label) -> void
+{
+    FECS::World world;
+
+    Benchmark bm(label);
+    world.Entities().Spawn<ComponentOne, ComponentTwo, ComponentThree>(
+        count,
+        [](std::size_t i) { return ComponentOne{(int) i}; },
+        [](std::size_t i) { return ComponentTwo{(int) i}; },
+        [](std::size_t i) { return ComponentThree{(int) i}; });
+}
+
+auto Benchmark_Instantiate(int count, const char* label) -> void
+{
+    FECS::World world;
+    FECS::Entity prototype = world.Entities()
+                                 .Create()
+                                 .Attach<ComponentOne>({1})
+                                 .Attach<ComponentTwo>({2})
+                                 .Attach<ComponentThree>({3})
+                                 .Build();
+
+    Benchmark bm(label);
+    world.Entities().Instantiate(prototype, count);
+}
+
+auto Benchmark_CreateRange(int count, const char* label) -> void
+{
+    FECS::World world;
+
+    Benchmark bm(label);
+    auto range = world.Entities().CreateRange(count);
+    DoNotOptimize(range.Size());
+}
+
+auto Benchmark_AoSFieldUpdate(int count, const char* label) -> void
+{
+    FECS::World world;
+    world.Entities().Spawn<Body>(count, [](std::size_t i) { return Body{(float) i, 0.0f, 0.0f, 0.0f}; });
+
+    Benchmark bm(label);
+    world.View()
+        .Query<Body>()
+        .EachChunk([](std::size_t count, const FECS::Entity* ids, Body* bodies)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            bodies[i].x *= 1.5f;
+        }
+    });
+}
+
+auto Benchmark_SoAFieldUpdate(int count, const char* label) -> void
+{
+    FECS::World world;
+    world.Entities().Spawn<SoABody>(count, [](std::size_t i) { return SoABody{(float) i, 0.0f, 0.0f, 0.0f}; });
+
+    Benchmark bm(label);
+    world.View()
+        .Query<SoABody>()
+        .EachChunk([](std::size_t count, const FECS::Entity* ids, FECS::SoAPtr<SoABody> bodies)
+    {
+        float* xs = bodies.get<&SoABody::x>();
+        for (std::size_t i = 0; i < count; i++)
+        {
+            xs[i] *= 1.5f;
+        }
+    });
+}
+
+// 1M entities, every 7th with the second component and every 11th with the third, attached in shuffled order
+template <bool PRESENCE>
+auto Benchmark_SelectiveJoin(int count, const char* label) -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> ids = world.Entities().CreateMany(count);
+    std::vector<FECS::Entity> shuffled = ids;
+    for (std::size_t i = shuffled.size() - 1; i > 0; --i)
+    {
+        std::swap(shuffled[i], shuffled[(i * 2654435761u) % (i + 1)]);
+    }
+
+    for (FECS::Entity e : shuffled)
+    {
+        std::uint32_t idx = FECS::GetEntityIndex(e);
+        world.Components().Attach(e, JoinComponent<1, PRESENCE>{1});
+        if (idx % 7 == 0)
+        {
+            world.Components().Attach(e, JoinComponent<2, PRESENCE>{1});
+        }
+        if (idx % 11 == 0)
+        {
+            world.Components().Attach(e, JoinComponent<3, PRESENCE>{1});
+        }
+    }
+
+    int matches = 0;
+    {
+        Benchmark bm(label);
+        world.View()
+            .Query<JoinComponent<1, PRESENCE>, JoinComponent<2, PRESENCE>, JoinComponent<3, PRESENCE>>()
+            .Each([&](FECS::Entity id, auto& one, auto& two, auto& three)
+        {
+            matches += one.x + two.x + three.x;
+        });
+    }
+    if (matches == 0)
+    {
+        std::cout << "No matches" << std::endl;
+    }
+}
+
 int main()
 {
     std::cout << "Running with " << NUM_ENTITIES << " entities" << std::endl;
@@ -167,12 +529,50 @@ int main()
         world.Components().Attach<ComponentTwo>(entities[i], {1});
         world.Components().Attach<ComponentThree>(entities[i], {1});
         world.Components().Attach<ComponentFour>(entities[i], {1});
+
+        world.Components().Attach<TableComponent<1>>(entities[i], {1});
+        world.Components().Attach<TableComponent<2>>(entities[i], {1});
+        world.Components().Attach<TableComponent<3>>(entities[i], {1});
+        world.Components().Attach<TableComponent<4>>(entities[i], {1});
+
+        if (i % 2 == 0)
+        {
+            world.Components().Attach<Frozen>(entities[i], {});
+        }
     }
 
     Benchmark_QueryTwoComponents(world);
     Benchmark_GetTwoComponents(world, entities);
     Benchmark_QueryFourComponents(world);
+    Benchmark_ParallelQueryFourComponents(world);
+    Benchmark_CachedQueryFourComponents(world);
+    Benchmark_GroupFourComponents(world);
+    Benchmark_TableQueryFourComponents(world);
+    Benchmark_TableChunkedQueryFourComponents(world);
+    Benchmark_LambdaFilteredQuery(world);
+    Benchmark_WithoutQuery(world);
     Benchmark_GetFourComponents(world, entities);
+    Benchmark_GetFourComponentsPooled(world, entities);
+
+    Benchmark_CreateLoop(10000, "Create 10k entities with 3 components, one by one");
+    Benchmark_Spawn(10000, "Create 10k entities with 3 components, Spawn");
+    Benchmark_Instantiate(10000, "Create 10k entities with 3 components, Instantiate");
+    Benchmark_CreateLoop(1000000, "Create 1M entities with 3 components, one by one");
+    Benchmark_Spawn(1000000, "Create 1M entities with 3 components, Spawn");
+    Benchmark_Instantiate(1000000, "Create 1M entities with 3 components, Instantiate");
+
+    Benchmark_CreateRange(1000000, "Create 1M entities without components, CreateRange");
+
+    Benchmark_DeleteLoop(10000, "Delete half of 10k entities, one by one");
+    Benchmark_DestroyBatch(10000, "Delete half of 10k entities, DestroyBatch");
+    Benchmark_DeleteLoop(1000000, "Delete half of 1M entities, one by one");
+    Benchmark_DestroyBatch(1000000, "Delete half of 1M entities, DestroyBatch");
+
+    Benchmark_AoSFieldUpdate(1000000, "Update one field of 1M entities, array of structs");
+    Benchmark_SoAFieldUpdate(1000000, "Update one field of 1M entities, struct of arrays");
+
+    Benchmark_SelectiveJoin<false>(1000000, "Join 3 components matching 1/77 of 1M entities, sparse lookups");
+    Benchmark_SelectiveJoin<true>(1000000, "Join 3 components matching 1/77 of 1M entities, presence bitmaps");
 
     return 0;
 }
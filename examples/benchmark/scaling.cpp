@@ -0,0 +1,85 @@
+#include <FECS/FECS.h>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark.h"
+
+#define NUM_ELEMENTS 4000000
+#define GRAIN_SIZE 16384
+#define NUM_TASKS 4096
+
+// Enough arithmetic per element that the loop is compute bound rather than memory bound
+static auto Work(float value) -> float
+{
+    for (int i = 0; i < 16; i++)
+    {
+        value = std::sqrt(value * value + 1.0f);
+    }
+    return value;
+}
+
+auto Benchmark_Serial(std::vector<float>& data) -> void
+{
+    Benchmark bm("Serial loop");
+    for (float& value : data)
+    {
+        value = Work(value);
+    }
+    DoNotOptimize(data.data());
+}
+
+auto Benchmark_ParallelFor(FECS::World& world, std::vector<float>& data) -> void
+{
+    std::string label = "ParallelFor (" + std::to_string(world.Jobs().WorkerCount()) + " workers + caller)";
+    Benchmark bm(label.c_str());
+    world.Jobs().ParallelFor(data.size(), GRAIN_SIZE, [&data](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            data[i] = Work(data[i]);
+        }
+    });
+    DoNotOptimize(data.data());
+}
+
+auto Benchmark_ForkJoin(FECS::World& world, std::vector<float>& data) -> void
+{
+    std::string label = "Fork/join " + std::to_string(NUM_TASKS) + " jobs (" + std::to_string(world.Jobs().WorkerCount()) + " workers + caller)";
+    Benchmark bm(label.c_str());
+    FECS::JobHandle handle;
+    std::size_t chunk = data.size() / NUM_TASKS;
+    for (std::size_t task = 0; task < NUM_TASKS; task++)
+    {
+        world.Jobs().Submit(handle, [&data, chunk, task]()
+        {
+            for (std::size_t i = task * chunk; i < (task + 1) * chunk; i++)
+            {
+                data[i] = Work(data[i]);
+            }
+        });
+    }
+    world.Jobs().Wait(handle);
+    DoNotOptimize(data.data());
+}
+
+int main()
+{
+    std::cout << "Running with " << NUM_ELEMENTS << " elements" << std::endl;
+    std::vector<float> data(NUM_ELEMENTS, 1.0f);
+
+    Benchmark_Serial(data);
+
+    std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t workers = 1; workers <= hardware; workers *= 2)
+    {
+        FECS::World world;
+        world.Jobs().SetWorkerCount(workers);
+
+        Benchmark_ParallelFor(world, data);
+        Benchmark_ForkJoin(world, data);
+    }
+
+    return 0;
+}
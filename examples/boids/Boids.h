@@ -5,6 +5,7 @@
 #include "Grid.h"
 #include "raymath.h"
 #include <FECS/FECS.h>
+#include <cstddef>
 #include <cstdint>
 
 #define PROTECTED_RANGE 8.0f
@@ -31,22 +32,23 @@ static float GetRandomFloat(float min, float max)
 
 static auto SpawnBoid(FECS::World& world) -> void
 {
-    for (int i = 0; i < 10000; i++)
+    world.Entities().Spawn<RenderComponent, PositionComponent, VelocityComponent>(
+        10000,
+        [](std::size_t)
     {
-        Vector2 pos = {
+        return RenderComponent{RandomPresetColor()};
+    },
+        [](std::size_t)
+    {
+        return PositionComponent{
             (float) GetRandomValue(0, SCREEN_WIDTH),
             (float) GetRandomValue(0, SCREEN_HEIGHT)};
-        Color color = RandomPresetColor();
-
+    },
+        [](std::size_t)
+    {
         float angle = GetRandomFloat(0.0f, 2.0f * PI);
-        Vector2 vel = {cosf(angle) * MIN_SPEED, sinf(angle) * MIN_SPEED};
-
-        world.Entities()
-            .Create()
-            .Attach<RenderComponent>({color})
-            .Attach<PositionComponent>({pos.x, pos.y})
-            .Attach<VelocityComponent>({vel.x, vel.y});
-    }
+        return VelocityComponent{cosf(angle) * MIN_SPEED, sinf(angle) * MIN_SPEED};
+    });
 }
 
 static auto ResolveVelocities(FECS::Query<PositionComponent, VelocityComponent> query) -> void
@@ -1,4 +1,7 @@
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <FECS/FECS.h>
 #include <FECS/Builder/EntityBuilder.h>
 
@@ -24,6 +27,28 @@ std::ostream& operator<<(std::ostream& stream, Velocity& vel)
     return stream << "Velocity: x:" << vel.x << ", y:" << vel.y;
 }
 
+struct Mass
+{
+    float value;
+};
+
+struct Charge
+{
+    float value;
+};
+
+template <>
+struct FECS::ComponentTraits<Mass> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::TABLE;
+};
+
+template <>
+struct FECS::ComponentTraits<Charge> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::TABLE;
+};
+
 #define MAX_ENTITIES 5
 auto ConstructEntities(FECS::World& world) -> void
 {
@@ -45,28 +70,1150 @@ auto ConstructEntities(FECS::World& world) -> void
     }
 }
 
-auto main() -> int
+struct Gravity
+{
+    float y;
+};
+
+auto ParallelScheduling() -> void
 {
     FECS::World world;
     ConstructEntities(world);
+    world.Resources().Emplace<Gravity>(-1.0f);
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
 
-    std::cout << "Position Entities" << std::endl;
+    // Velocity writers conflict with each other, the Position reader may overlap with them
+    world.Scheduler()
+        .AddSystem()
+        .Read<Gravity>()
+        .WithQuery<Velocity>()
+        .Build([](const Gravity& gravity, FECS::Query<Velocity> query)
+    {
+        query.Each([&gravity](FECS::Entity id, Velocity& vel)
+        {
+            vel.y += gravity.y;
+        });
+    });
+
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<Velocity>()
+        .Build([](FECS::Query<Velocity> query)
+    {
+        query.Each([](FECS::Entity id, Velocity& vel)
+        {
+            vel.x *= 0.5f;
+        });
+    });
+
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Position>()
+        .Build([](FECS::Query<const Position> query)
+    {
+        query.Each([](FECS::Entity id, const Position& pos)
+        {
+        });
+    });
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+        world.Scheduler().Run(0.016f);
+    }
+
+    std::cout << std::endl
+              << "Velocity Entities after 3 parallel frames" << std::endl;
+    world.View()
+        .Query<const Velocity>()
+        .Each([](FECS::Entity id, const Velocity& vel)
+    {
+        std::cout << id << " Velocity: x:" << vel.x << ", y:" << vel.y << std::endl;
+    });
+}
+
+auto ParallelQueries() -> void
+{
+    FECS::World world;
+    for (int i = 0; i < 10000; i++)
+    {
+        world.Entities()
+            .Create()
+            .Attach(Position{(float) i, 1.0f})
+            .Attach(Velocity{1.0f, 1.0f})
+            .Build();
+    }
+
+    world.View()
+        .Query<Position, const Velocity>()
+        .ParallelEach([](FECS::Entity id, Position& pos, const Velocity& vel)
+    {
+        pos.x += vel.x;
+    }, 256);
+
+    auto query = world.View().Query<const Position>();
+    float total = query.ParallelReduce(0.0f, [](FECS::Entity id, const Position& pos)
+    {
+        return pos.y;
+    }, FECS::Reduce::Sum{}, 256);
+    float largest = query.ParallelReduce(0.0f, [](FECS::Entity id, const Position& pos)
+    {
+        return pos.x;
+    }, FECS::Reduce::Max{}, 256);
+
+    std::cout << std::endl
+              << "Parallel reductions over 10000 entities" << std::endl;
+    std::cout << "Sum of y: " << total << std::endl;
+    std::cout << "Max of x: " << largest << std::endl;
+}
+
+auto DeferredCommands() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
+
+    // Structural changes recorded while iterating land at the end of the set
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Position>()
+        .WithCommands()
+        .Build([](FECS::Query<const Position> query, FECS::Commands& commands)
+    {
+        query.Each([&commands](FECS::Entity id, const Position& pos)
+        {
+            if (pos.x == 0.0f)
+            {
+                commands.Destroy(id);
+            }
+            else
+            {
+                commands.Attach(id, Velocity{-1.0f, -1.0f});
+            }
+        });
+
+        FECS::Container::PendingEntity spawned = commands.Create();
+        commands.Attach(spawned, Position{100.0f, 100.0f});
+    });
+
+    world.Scheduler().Run(0.016f);
+
+    std::cout << std::endl
+              << "Entities after deferred commands" << std::endl;
     world.View()
         .Query<Position>()
         .Each([](FECS::Entity id, Position& pos)
     {
         std::cout << id << " " << pos << std::endl;
     });
+    std::cout << "Velocity count: " << world.Components().GetStorages().GetPool<Velocity>()->Size() << std::endl;
+}
+
+auto ParallelCommands() -> void
+{
+    FECS::World world;
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
+    world.Entities().Spawn<Position>(10000, [](std::size_t i)
+    {
+        return Position{(float) i, 0.0f};
+    });
+
+    // Every worker of the ParallelEach records into its own buffer
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Position>()
+        .WithCommands()
+        .Build([](FECS::Query<const Position> query, FECS::Commands& commands)
+    {
+        query.ParallelEach([&commands](FECS::Entity id, const Position& pos)
+        {
+            if (FECS::GetEntityIndex(id) % 4 == 0)
+            {
+                commands.Attach(id, Velocity{pos.x, 0.0f});
+            }
+        }, 256);
+    });
+    world.Scheduler().Run(0.016f);
 
     std::cout << std::endl
-              << "Position & Velocity Entities" << std::endl;
+              << "Commands recorded from ParallelEach: " << world.Components().GetStorages().GetPool<Velocity>()->Size() << std::endl;
+}
+
+auto CachedQueries() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    auto& query = world.View().Cached<Position, const Velocity>();
+    std::cout << std::endl
+              << "Cached Position & Velocity count: " << query.Size() << std::endl;
+
+    // Overwriting a component keeps the cache, attaching a new one rebuilds it
+    FECS::Entity extra = world.Entities().Create().Attach(Position{7.0f, 7.0f}).Build();
+    world.Components().Attach(extra, Velocity{1.0f, 1.0f});
+    std::cout << "After attaching Velocity: " << query.Size() << std::endl;
+
+    world.Components().Detach<Velocity>(extra);
+    query.Each([](FECS::Entity id, Position& pos, const Velocity& vel)
+    {
+        std::cout << id << " " << pos << std::endl;
+    });
+}
+
+auto OwningGroups() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    auto group = world.View().Group<Position, const Velocity>();
+    std::cout << std::endl
+              << "Group Position & Velocity: " << group.Size() << std::endl;
+
+    FECS::Entity extra = world.Entities().Create().Attach(Position{5.0f, 5.0f}).Build();
+    world.Components().Attach(extra, Velocity{1.0f, 1.0f});
+    world.Components().Detach<Velocity>(0);
+    world.Entities().Delete(2);
+
+    group.Each([](FECS::Entity id, Position& pos, const Velocity& vel)
+    {
+        std::cout << id << " " << pos << std::endl;
+    });
+
+    // Any spelling of the same components shares one group
+    auto swapped = world.View().Group<const Velocity, Position>();
+    auto& storages = world.Components().GetStorages();
+    std::cout << "Swapped spelling shares the group " << (storages.GetGroup<Velocity, Position>() == storages.GetGroup<Position, Velocity>())
+              << ", size " << swapped.Size() << std::endl;
+}
+
+auto TableStorage() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    // Mass and Charge live in archetype tables, Position stays in its sparse set
+    for (FECS::Entity id = 0; id < MAX_ENTITIES; id++)
+    {
+        world.Components().Attach(id, Mass{(float) id});
+        if (id % 2 == 1)
+        {
+            world.Components().Attach(id, Charge{-1.0f});
+        }
+    }
+    world.Components().Detach<Mass>(3);
+    world.Entities().Delete(0);
+
+    std::cout << std::endl
+              << "Table Mass & Charge Entities" << std::endl;
     world.View()
-        .Query<Position, Velocity>()
-        .Each([](FECS::Entity id, Position& pos, Velocity& vel)
+        .Query<const Mass, Charge, Position>()
+        .Each([](FECS::Entity id, const Mass& mass, Charge& charge, Position& pos)
+    {
+        std::cout << id << " mass:" << mass.value << " charge:" << charge.value << " " << pos << std::endl;
+    });
+
+    float totalMass = world.View()
+                          .Query<const Mass>()
+                          .ParallelReduce(0.0f, [](FECS::Entity id, const Mass& mass)
+    {
+        return mass.value;
+    }, FECS::Reduce::Sum{});
+    std::cout << "Total mass: " << totalMass << std::endl;
+
+    std::cout << "Mass without Charge:";
+    world.View()
+        .Query<const Mass, FECS::Without<Charge>>()
+        .Each([](FECS::Entity id, const Mass& mass)
+    {
+        std::cout << " " << id;
+    });
+    std::cout << std::endl;
+}
+
+auto ChunkedIteration() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    // Contiguous pool data, the loop body is free to vectorize
+    world.View()
+        .Query<Position>()
+        .EachChunk([](std::size_t count, const FECS::Entity* ids, Position* pos)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            pos[i].y += 0.5f;
+        }
+    });
+
+    // Gathered blocks, Position is written back afterwards
+    world.View()
+        .Query<Position, const Velocity>()
+        .EachChunk([](std::size_t count, const FECS::Entity* ids, Position* pos, const Velocity* vel)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            pos[i].x += vel[i].x;
+        }
+    }, 2);
+
+    std::cout << std::endl
+              << "Positions after chunked iteration" << std::endl;
+    world.View()
+        .Query<Position>()
+        .Each([](FECS::Entity id, Position& pos)
     {
         std::cout << id << " " << pos << std::endl;
-        std::cout << id << " " << vel << std::endl;
     });
+}
+
+struct Frozen
+{
+};
+
+auto FilteredQueries() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Components().Attach(2, Frozen{});
+    world.Components().Attach(3, Mass{3.0f});
+
+    std::cout << std::endl
+              << "Moving entities that aren't frozen" << std::endl;
+    world.View()
+        .Query<Position, const Velocity, FECS::Without<Frozen>>()
+        .Each([](FECS::Entity id, Position& pos, const Velocity& vel)
+    {
+        std::cout << id << " " << pos << std::endl;
+    });
+
+    std::cout << "Positions with optional Velocity" << std::endl;
+    world.View()
+        .Query<const Position, FECS::Optional<const Velocity>>()
+        .Each([](FECS::Entity id, const Position& pos, const Velocity* vel)
+    {
+        std::cout << id << (vel ? " moving" : " static") << std::endl;
+    });
+
+    std::cout << "Frozen or heavy" << std::endl;
+    world.View()
+        .Query<const Position, FECS::AnyOf<Frozen, Mass>>()
+        .Each([](FECS::Entity id, const Position& pos)
+    {
+        std::cout << id << std::endl;
+    });
+}
+
+struct Health
+{
+    int value;
+};
+
+template <>
+struct FECS::ComponentTraits<Health> : FECS::DefaultComponentTraits
+{
+    static constexpr bool trackChanges = true;
+};
+
+auto ChangeDetection() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Components().Attach(1, Health{100});
+    world.Components().Attach(2, Health{100});
+
+    std::size_t added = 0;
+    std::size_t changed = 0;
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Health, FECS::Added<Health>>()
+        .WithQuery<const Health, FECS::Changed<Health>>()
+        .Build([&](FECS::Query<const Health, FECS::Added<Health>> addedQuery, FECS::Query<const Health, FECS::Changed<Health>> changedQuery)
+    {
+        added = 0;
+        changed = 0;
+        addedQuery.Each([&](FECS::Entity id, const Health& health) { added++; });
+        changedQuery.Each([&](FECS::Entity id, const Health& health) { changed++; });
+    });
+
+    auto run = [&](const char* label)
+    {
+        world.Scheduler().Run(0.016f);
+        std::cout << label << ": added " << added << ", changed " << changed << std::endl;
+    };
+
+    std::cout << std::endl
+              << "Change detection" << std::endl;
+    run("First run");
+    run("Idle run");
+
+    // Reading through const access doesn't count as a change
+    world.View()
+        .Query<const Health>()
+        .Each([](FECS::Entity id, const Health& health) {});
+    run("After read");
+
+    world.Components().Attach(1, Health{50});
+    world.Components().Attach(3, Health{100});
+    run("After overwrite and attach");
+
+    world.View()
+        .Query<Health>()
+        .Each([](FECS::Entity id, Health& health)
+    {
+        health.value--;
+    });
+    run("After mutable query");
+}
+
+auto CachedQueryTicks() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Components().Attach(1, Health{100});
+    world.Components().Attach(2, Health{100});
+
+    // Writes through a system's cached query are stamped with the run's tick, like its other queries
+    std::size_t ownChanged = 0;
+    std::size_t laterChanged = 0;
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Health, FECS::Changed<Health>>()
+        .WithCachedQuery<Health>()
+        .Build([&](FECS::Query<const Health, FECS::Changed<Health>> changedQuery, FECS::CachedQuery<Health>& cached)
+    {
+        ownChanged = 0;
+        changedQuery.Each([&](FECS::Entity id, const Health& health) { ownChanged++; });
+        cached.Each([](FECS::Entity id, Health& health) { health.value--; });
+    });
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Health, FECS::Changed<Health>>()
+        .Build([&](FECS::Query<const Health, FECS::Changed<Health>> changedQuery)
+    {
+        laterChanged = 0;
+        changedQuery.Each([&](FECS::Entity id, const Health& health) { laterChanged++; });
+    });
+
+    std::cout << std::endl
+              << "Cached query writes" << std::endl;
+    for (const char* label : {"First run", "Second run"})
+    {
+        world.Scheduler().Run(0.016f);
+        std::cout << label << ": writer sees " << ownChanged << ", later system sees " << laterChanged << std::endl;
+    }
+}
+
+auto ComponentMasks() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Components().Attach(1, Mass{1.0f});
+
+    std::cout << std::endl
+              << "Component masks" << std::endl;
+    for (FECS::Entity id = 0; id < 5; id++)
+    {
+        std::cout << id << " all " << world.Components().HasAll<Position, Velocity>(id)
+                  << " any " << world.Components().HasAny<Velocity, Mass>(id) << std::endl;
+    }
+
+    world.Entities().Delete(1);
+    std::cout << "After deleting 1: " << world.Components().HasAny<Position, Velocity, Mass>(1)
+              << ", positions left " << world.Components().GetStorages().GetPool<Position>()->Size() << std::endl;
+}
+
+auto BatchDestruction() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+    world.Components().Attach(3, Mass{3.0f});
+
+    std::vector<FECS::Entity> doomed = {0, 3, 3, 42};
+    world.Entities().DestroyBatch(doomed);
+
+    std::cout << std::endl
+              << "Entities after batch destruction" << std::endl;
+    world.View()
+        .Query<Position>()
+        .Each([](FECS::Entity id, Position& pos)
+    {
+        std::cout << id << " " << pos << std::endl;
+    });
+
+    world.Entities().DestroyAll(world.View().Query<const Velocity>());
+    std::cout << "Alive after destroying movers: ";
+    for (FECS::Entity id = 0; id < MAX_ENTITIES; id++)
+    {
+        std::cout << world.Entities().IsAlive(id);
+    }
+    std::cout << ", positions left " << world.Components().GetStorages().GetPool<Position>()->Size() << std::endl;
+}
+
+auto BulkSpawn() -> void
+{
+    FECS::World world;
+
+    std::vector<Position> positions = {{1.0f, 1.0f}, {2.0f, 2.0f}, {3.0f, 3.0f}};
+    std::vector<FECS::Entity> spawned = world.Entities().Spawn<Position, Velocity, Mass>(
+        3,
+        positions,
+        [](std::size_t i)
+    {
+        return Velocity{(float) i, 0.0f};
+    },
+        [](std::size_t i)
+    {
+        return Mass{10.0f};
+    });
+
+    std::vector<FECS::Entity> copies = world.Entities().Instantiate(spawned[1], 2);
+
+    std::cout << std::endl
+              << "Spawned and instantiated entities" << std::endl;
+    world.View()
+        .Query<Position, const Velocity, const Mass>()
+        .Each([](FECS::Entity id, Position& pos, const Velocity& vel, const Mass& mass)
+    {
+        std::cout << id << " " << pos << " dx:" << vel.x << " mass:" << mass.value << std::endl;
+    });
+}
+
+struct Transform
+{
+    float x, y, angle;
+};
+
+template <>
+struct FECS::ComponentTraits<Transform> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::PAGED;
+};
+
+auto PagedStorage() -> void
+{
+    FECS::World world;
+
+    FECS::Entity first = world.Entities()
+                             .Create()
+                             .Attach(Transform{1.0f, 2.0f, 0.0f})
+                             .Build();
+    Transform* address = &world.Components().Get<Transform>(first);
+
+    std::vector<FECS::Entity> entities = world.Entities().CreateMany(10000);
+    for (FECS::Entity e : entities)
+    {
+        world.Components().Attach<Transform>(e, Transform{0.0f, 0.0f, 1.0f});
+    }
+
+    float angles = 0.0f;
+    std::size_t chunks = 0;
+    world.View()
+        .Query<Transform>()
+        .EachChunk([&](std::size_t count, const FECS::Entity*, Transform* transforms)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            angles += transforms[i].angle;
+        }
+        chunks++;
+    });
+
+    std::cout << std::endl
+              << "Paged storage address stable: " << (address == &world.Components().Get<Transform>(first))
+              << ", x " << address->x << ", angles " << angles << ", chunked " << (chunks > 1) << std::endl;
+}
+
+struct Boss
+{
+    float rage;
+};
+
+template <>
+struct FECS::ComponentTraits<Boss> : FECS::DefaultComponentTraits
+{
+    static constexpr std::size_t sparsePageSize = 64;
+    static constexpr std::size_t alignment = FECS::CACHE_LINE_SIZE;
+    static constexpr std::size_t growth = 4;
+};
+
+auto StorageTraits() -> void
+{
+    FECS::World world;
+
+    std::vector<FECS::Entity> entities = world.Entities().CreateMany(1000);
+    world.Components().Attach<Boss>(entities[999], Boss{1.0f});
+    world.Components().Attach<Boss>(entities[10], Boss{2.0f});
+
+    auto* pool = world.Components().GetStorages().GetPool<Boss>();
+    auto address = reinterpret_cast<std::uintptr_t>(pool->GetDataVector().data());
+
+    std::cout << std::endl
+              << "Boss pool page size " << pool->PAGE_SIZE << ", cache line aligned " << (address % FECS::CACHE_LINE_SIZE == 0)
+              << ", rage " << world.Components().Get<Boss>(entities[999]).rage + world.Components().Get<Boss>(entities[10]).rage << std::endl;
+}
+
+struct Enemy
+{
+};
+
+struct Marker
+{
+    Marker() {}
+};
+
+auto TagComponents() -> void
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    for (FECS::Entity id = 0; id < MAX_ENTITIES; id += 2)
+    {
+        world.Entities().Create().Attach(Position{-1.0f, -1.0f}).Tag<Enemy>();
+    }
+
+    std::size_t enemies = 0;
+    std::size_t chunked = 0;
+    world.View()
+        .Query<const Position, Enemy>()
+        .Each([&](FECS::Entity id, const Position& pos, Enemy&)
+    {
+        enemies++;
+    });
+    world.View()
+        .Query<Enemy>()
+        .EachChunk([&](std::size_t count, const FECS::Entity*, Enemy*)
+    {
+        chunked += count;
+    });
+
+    auto* pool = world.Components().GetStorages().GetPool<Enemy>();
+    std::cout << std::endl
+              << "Tagged enemies " << enemies << ", chunked " << chunked << ", tag pool stores values "
+              << !std::is_same_v<FECS::Container::SparseSet<Enemy>::DenseStorage, tag_vector<Enemy>> << ", size " << pool->Size() << std::endl;
+
+    // Empty but not trivial, so it keeps a regular pool
+    world.Components().Attach(world.Entities().Create().Build(), Marker{});
+    std::cout << "Non-trivial empty component is a tag " << FECS::IS_TAG_COMPONENT<Marker>
+              << ", size " << world.Components().GetStorages().GetPool<Marker>()->Size() << std::endl;
+}
+
+struct Particle
+{
+    float x, y;
+    int age;
+};
+
+template <>
+struct FECS::ComponentTraits<Particle> : FECS::DefaultComponentTraits
+{
+    static constexpr FECS::StorageKind storage = FECS::StorageKind::SOA;
+    static constexpr auto fields = std::make_tuple(&Particle::x, &Particle::y, &Particle::age);
+};
+
+auto SoAStorage() -> void
+{
+    FECS::World world;
+
+    std::vector<FECS::Entity> entities = world.Entities().Spawn<Particle>(4, [](std::size_t i)
+    {
+        return Particle{(float) i, (float) i * 2.0f, 0};
+    });
+    world.Entities().Delete(entities[1]);
+
+    world.View()
+        .Query<Particle>()
+        .EachChunk([](std::size_t count, const FECS::Entity*, FECS::SoAPtr<Particle> particles)
+    {
+        float* xs = particles.get<&Particle::x>();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            xs[i] += 10.0f;
+        }
+    });
+
+    std::cout << std::endl
+              << "SoA particles" << std::endl;
+    world.View()
+        .Query<const Particle>()
+        .Each([](FECS::Entity id, FECS::SoARef<const Particle> particle)
+    {
+        Particle copy = particle;
+        std::cout << id << " x:" << particle.get<&Particle::x>() << " y:" << copy.y << std::endl;
+    });
+
+    auto* pool = world.Components().GetStorages().GetPool<Particle>();
+    auto address = reinterpret_cast<std::uintptr_t>(pool->GetDataVector().data().get<&Particle::y>());
+    std::cout << "Field arrays aligned " << (address % FECS::SOA_FIELD_ALIGNMENT == 0) << std::endl;
+}
+
+struct Rare
+{
+    int id;
+};
+
+auto AdaptiveSparseIndex() -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> entities = world.Entities().CreateMany(100000);
+
+    // A few components scattered over the whole index space stay hashed
+    for (std::size_t i = 0; i < entities.size(); i += 10000)
+    {
+        world.Components().Attach(entities[i], Rare{(int) i});
+    }
+    for (FECS::Entity e : entities)
+    {
+        world.Components().Attach(e, Position{1.0f, 1.0f});
+    }
+
+    auto& storages = world.Components().GetStorages();
+    FECS::Container::PoolMemory rare = storages.GetPool<Rare>()->GetMemoryUsage();
+    FECS::Container::PoolMemory dense = storages.GetPool<Position>()->GetMemoryUsage();
+
+    bool found = true;
+    for (std::size_t i = 0; i < entities.size(); i += 10000)
+    {
+        found = found && world.Components().Get<Rare>(entities[i]).id == (int) i && !world.Components().Has<Rare>(entities[i] + 1);
+    }
+
+    std::cout << std::endl
+              << "Rare pool hashed " << rare.hashed << ", sparse under 1KB " << (rare.sparse < 1024) << ", found " << found << std::endl
+              << "Dense pool hashed " << dense.hashed << ", pages " << dense.sparsePages << std::endl;
+
+    // Emptying pages hands them back, the pool turns back into a hash map
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        if (i % 1000 != 0)
+        {
+            world.Components().Detach<Position>(entities[i]);
+        }
+    }
+    dense = storages.GetPool<Position>()->GetMemoryUsage();
+    std::size_t left = 0;
+    world.View()
+        .Query<Position>()
+        .Each([&](FECS::Entity id, Position& pos)
+    {
+        left += world.Components().Get<Position>(id).x == 1.0f;
+    });
+    std::cout << "After detaching: hashed " << dense.hashed << ", pages " << dense.sparsePages << ", left " << left << std::endl;
+
+    // The presence bitmap only allocates the pages holding set bits
+    FECS::World far;
+    auto range = far.Entities().CreateRange(1000000);
+    far.Components().Attach(range[999999], Rare{1});
+    FECS::Container::PoolMemory lone = far.Components().GetStorages().GetPool<Rare>()->GetMemoryUsage();
+    std::cout << "Lone component at index 999999: presence " << lone.presence << " bytes, total under 8KB " << (lone.Total() < 8192) << std::endl;
+}
+
+struct Unmapped
+{
+    int id;
+};
+
+template <>
+struct FECS::ComponentTraits<Unmapped> : FECS::DefaultComponentTraits
+{
+    static constexpr bool presenceBitmap = false;
+};
+
+auto PresenceJoin() -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> entities = world.Entities().CreateMany(10000);
+    for (FECS::Entity e : entities)
+    {
+        std::uint32_t idx = FECS::GetEntityIndex(e);
+        world.Components().Attach(e, Position{(float) idx, 0.0f});
+        if (idx % 3 == 0)
+        {
+            world.Components().Attach(e, Velocity{1.0f, 1.0f});
+        }
+        if (idx % 5 == 0)
+        {
+            world.Components().Attach(e, Frozen{});
+        }
+        if (idx % 7 == 0)
+        {
+            world.Components().Attach(e, Unmapped{(int) idx});
+        }
+    }
+
+    // Every third entity moves, unless it's frozen
+    std::size_t moving = 0;
+    bool inOrder = true;
+    FECS::Entity previous = 0;
+    world.View()
+        .Query<Position, const Velocity, FECS::Without<Frozen>>()
+        .Each([&](FECS::Entity id, Position& pos, const Velocity&)
+    {
+        inOrder = inOrder && (moving == 0 || id > previous);
+        previous = id;
+        moving += (int) pos.x % 3 == 0 && (int) pos.x % 5 != 0;
+    });
+
+    // Unmapped has no bitmap and is checked through its sparse pages
+    std::size_t unmapped = 0;
+    world.View()
+        .Query<Velocity, Unmapped>()
+        .Each([&](FECS::Entity id, Velocity&, Unmapped& u)
+    {
+        unmapped += u.id % 21 == 0;
+    });
+
+    FECS::Container::PoolMemory memory = world.Components().GetStorages().GetPool<Velocity>()->GetMemoryUsage();
+    std::cout << std::endl
+              << "Moving and not frozen: " << moving << ", in index order " << inOrder << std::endl
+              << "With Velocity and Unmapped: " << unmapped << ", Velocity presence bytes " << memory.presence << std::endl;
+}
+
+auto EntityHandles() -> void
+{
+    using Wide = FECS::EntityTraits64;
+    static_assert(Wide::Index(Wide::Build(50000000, 7)) == 50000000 && Wide::Version(Wide::Build(50000000, 7)) == 7);
+
+    // Recycling one slot past the last version wraps back to version 0
+    using Narrow = FECS::EntityTraits32;
+    FECS::Container::BasicEntityStorage<Narrow> storage;
+    Narrow::Type first = storage.Create();
+    Narrow::Type e = first;
+    for (std::uint32_t i = 0; i <= Narrow::MAX_VERSION; ++i)
+    {
+        storage.Destroy(e);
+        e = storage.Create();
+    }
+
+    std::cout << std::endl
+              << "Handle bits " << sizeof(FECS::Entity) * 8 << ", index bits " << FECS::INDEX_BITS << std::endl
+              << "Same slot " << (Narrow::Index(e) == Narrow::Index(first)) << ", version " << Narrow::Version(e)
+              << ", alive " << storage.IsAlive(e) << std::endl;
+}
+
+auto EntityRanges() -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> first = world.Entities().CreateMany(4);
+    world.Entities().Delete(first[1]);
+    world.Entities().Delete(first[2]);
+    world.Entities().Delete(first[2]);
+
+    // Ranges skip the free slots, Create reuses them with a bumped version
+    auto range = world.Entities().CreateRange(3);
+    FECS::Entity recycled = world.Entities().Create().Build();
+
+    std::cout << std::endl
+              << "Range from index " << range.FirstIndex() << ": ";
+    for (FECS::Entity e : range)
+    {
+        std::cout << FECS::GetEntityIndex(e) << " ";
+    }
+    std::cout << std::endl
+              << "Recycled index " << FECS::GetEntityIndex(recycled) << " version " << FECS::GetEntityVersion(recycled)
+              << ", stale handle alive " << world.Entities().IsAlive(first[2]) << std::endl;
+
+    std::cout << "Alive (" << world.Entities().AliveCount() << "):";
+    world.Entities().EachAlive([](FECS::Entity e)
+    {
+        std::cout << " " << FECS::GetEntityIndex(e);
+    });
+    std::cout << std::endl;
+}
+
+auto ReservedEntities() -> void
+{
+    FECS::World world;
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
+    std::vector<FECS::Entity> ids = world.Entities().Spawn<Position>(10000, [](std::size_t i)
+    {
+        return Position{(float) i, 0.0f};
+    });
+    world.Entities().DestroyBatch(std::span<const FECS::Entity>(ids).first(100));
+
+    // Workers of a spawning system reserve ids without locking, the free slots are handed out first
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Position>()
+        .WithCommands()
+        .Build([](FECS::Query<const Position> query, FECS::Commands& commands)
+    {
+        query.ParallelEach([&commands](FECS::Entity id, const Position& pos)
+        {
+            if (FECS::GetEntityIndex(id) % 10 == 0)
+            {
+                FECS::Entity spawned = commands.Reserve();
+                commands.Attach(spawned, Velocity{pos.x, 0.0f});
+            }
+        }, 256);
+    });
+    // A second reader makes the set dispatch in parallel, reservations don't disturb its iteration
+    std::size_t read = 0;
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<const Position>()
+        .Build([&read](FECS::Query<const Position> query)
+    {
+        query.Each([&read](FECS::Entity id, const Position&) { read++; });
+    });
+
+    std::size_t before = world.Entities().AliveCount();
+    world.Scheduler().Run(0.016f);
+
+    std::size_t recycled = 0;
+    world.View()
+        .Query<const Velocity>()
+        .Each([&recycled](FECS::Entity id, const Velocity&)
+    {
+        recycled += FECS::GetEntityIndex(id) < 100;
+    });
+
+    std::cout << std::endl
+              << "Reserved entities alive after the flush: " << world.Entities().AliveCount() - before
+              << ", recycled " << recycled << ", total " << world.Entities().AliveCount() << ", read " << read << std::endl;
+}
+
+auto PoolHandles() -> void
+{
+    FECS::World world;
+    std::vector<FECS::Entity> ids = world.Entities().Spawn<Position>(4, [](std::size_t i)
+    {
+        return Position{(float) i, 0.0f};
+    });
+    world.Components().Attach<Velocity>(ids[1], {10.0f, 0.0f});
+    world.Components().Attach<Velocity>(ids[3], {20.0f, 0.0f});
+
+    // The handle is bound when the system is built, lookups inside the loop skip the registry
+    const void* bound = nullptr;
+    world.Scheduler()
+        .AddSystem()
+        .WithQuery<Position>()
+        .WithPool<const Velocity>()
+        .Build([&bound](FECS::Query<Position> query, FECS::Lookup<const Velocity> velocities)
+    {
+        bound = velocities.GetPool();
+        query.Each([&velocities](FECS::Entity id, Position& pos)
+        {
+            if (const Velocity* vel = velocities.TryGet(id))
+            {
+                pos.x += vel->x;
+            }
+        });
+    });
+    world.Scheduler().Run(0.016f);
+
+    auto query = world.View().Query<const Position>();
+    FECS::Lookup<const Position> positions = query.Pool<const Position>();
+    FECS::Pool<Velocity> velocities = world.Components().Pool<Velocity>();
+    velocities.Remove(ids[3]);
+
+    std::cout << std::endl
+              << "Pool handles: x of last " << positions.Get(ids[3]).x << ", same pool "
+              << (positions.GetPool() == world.Components().GetStorages().GetPool<Position>())
+              << ", velocities " << velocities.Size() << ", system handle bound " << (bound == velocities.GetPool()) << std::endl;
+}
+
+template <typename Handle>
+concept StructuralHandle = requires(Handle handle, FECS::Entity e) { handle.Remove(e); };
+
+auto ParallelPoolHandles() -> void
+{
+    static_assert(StructuralHandle<FECS::Pool<Velocity>> && !StructuralHandle<FECS::Lookup<Velocity>>);
+
+    FECS::World world;
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
+    std::vector<FECS::Entity> ids = world.Entities().Spawn<Position, Velocity>(1000, [](std::size_t i)
+    {
+        return Position{(float) i, 0.0f};
+    }, [](std::size_t i)
+    {
+        return Velocity{1.0f, 0.0f};
+    });
+
+    // Handles of different components may run side by side, their structural changes are deferred
+    world.Scheduler()
+        .AddSystem()
+        .WithPool<Position>()
+        .WithCommands()
+        .Build([&ids](FECS::Lookup<Position> positions, FECS::Commands& commands)
+    {
+        for (FECS::Entity id : ids)
+        {
+            positions.Get(id).y += 1.0f;
+            if (FECS::GetEntityIndex(id) % 2 == 0)
+            {
+                commands.Attach(id, Health{1});
+            }
+        }
+    });
+    world.Scheduler()
+        .AddSystem()
+        .WithPool<Velocity>()
+        .WithCommands()
+        .Build([&ids](FECS::Lookup<Velocity> velocities, FECS::Commands& commands)
+    {
+        for (FECS::Entity id : ids)
+        {
+            velocities.Get(id).y += 1.0f;
+            if (FECS::GetEntityIndex(id) % 3 == 0)
+            {
+                commands.Detach<Velocity>(id);
+            }
+        }
+    });
+    world.Scheduler().Run(0.016f);
+
+    // Destroying every entity only visits the pools its signature lists, stale bits would leave components behind
+    world.Entities().DestroyBatch(ids);
+    std::cout << std::endl
+              << "Parallel pool handle writers: health " << world.Components().GetStorages().GetPool<Health>()->Size()
+              << ", velocities " << world.Components().GetStorages().GetPool<Velocity>()->Size()
+              << ", positions " << world.Components().GetStorages().GetPool<Position>()->Size() << std::endl;
+}
+
+struct Replicated
+{
+    int value;
+};
+
+auto StableTypeIds() -> void
+{
+    static_assert(FECS::TYPE_ID<Position> == FECS::TYPE_ID<const Position>);
+    static_assert(FECS::TYPE_ID<Position> != FECS::TYPE_ID<Velocity>);
+
+    FECS::World world;
+
+    // First uses racing on several workers all get the same index
+    std::atomic<std::uint32_t> mismatches = 0;
+    std::uint32_t expected = ComponentIndex::GetIndex<Replicated>();
+    world.Jobs().ParallelFor(64, 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            mismatches += ComponentIndex::GetIndex<Replicated>() != expected;
+        }
+    });
+
+    world.Components().Register<Replicated>();
+    world.Components().Attach<Replicated>(world.Entities().Create().Build(), {7});
+    FECS::Container::ISparseSet* pool = world.Components().GetStorages().GetPoolById(FECS::TYPE_ID<Replicated>);
+    std::uint32_t idx = ComponentIndex::Find(FECS::TYPE_ID<Replicated>);
+
+    std::cout << std::endl
+              << "Type " << FECS::TypeInfo<Replicated>::name << ": pool found " << (pool == world.Components().GetStorages().GetPool<Replicated>())
+              << ", name by index " << ComponentIndex::NameOf(idx) << ", mismatches " << mismatches << std::endl;
+}
+
+struct Score
+{
+    int value;
+};
+
+auto ResourceConflicts() -> void
+{
+    FECS::World world;
+    world.Resources().Emplace<Score>(0);
+    world.Scheduler().SetExecutionMode(FECS::ExecutionMode::PARALLEL);
+
+    // Both systems write Score, so the scheduler must never run them side by side
+    std::atomic<int> active = 0;
+    std::atomic<int> overlaps = 0;
+    auto writer = [&active, &overlaps](Score& score)
+    {
+        overlaps += active.fetch_add(1) != 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        score.value++;
+        active.fetch_sub(1);
+    };
+    world.Scheduler().AddSystem().Write<Score>().Build(writer);
+    world.Scheduler().AddSystem().Write<Score>().Build(writer);
+
+    for (int frame = 0; frame < 5; frame++)
+    {
+        world.Scheduler().Run(0.016f);
+    }
+
+    FECS::Internal::SystemAccess a;
+    FECS::Internal::SystemAccess b;
+    a.resourceWrites.push_back(FECS::TYPE_ID<Score>);
+    b.resourceWrites.push_back(FECS::TYPE_ID<Score>);
+
+    std::cout << std::endl
+              << "Score writers conflict " << a.ConflictsWith(b) << ", overlapping runs " << overlaps
+              << ", score " << world.Resources().Get<Score>().value << std::endl;
+}
+
+auto WorldShutdown() -> void
+{
+    std::atomic<int> finished = 0;
+    {
+        FECS::World world;
+        world.Entities().CreateMany(3);
+
+        // Jobs still queued when the world goes away run before any manager is destroyed
+        for (int i = 0; i < 4; i++)
+        {
+            world.Jobs().Submit([&world, &finished]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                finished += world.Entities().AliveCount() == 3;
+            });
+        }
+    }
+
+    std::cout << std::endl
+              << "Jobs finished before the world was destroyed: " << finished << std::endl;
+}
+
+auto main() -> int
+{
+    FECS::World world;
+    ConstructEntities(world);
+
+    std::cout << "Position Entities" << std::endl;
+    world.View()
+        .Query<Position>()
+        .Each([](FECS::Entity id, Position& pos)
+    {
+        std::cout << id << " " << pos << std::endl;
+    });
+
+    std::cout << std::endl
+              << "Position & Velocity Entities" << std::endl;
+    world.View()
+        .Query<Position, Velocity>()
+        .Each([](FECS::Entity id, Position& pos, Velocity& vel)
+    {
+        std::cout << id << " " << pos << std::endl;
+        std::cout << id << " " << vel << std::endl;
+    });
+
+    ParallelScheduling();
+    ParallelQueries();
+    DeferredCommands();
+    ParallelCommands();
+    CachedQueries();
+    OwningGroups();
+    TableStorage();
+    ChunkedIteration();
+    FilteredQueries();
+    ChangeDetection();
+    CachedQueryTicks();
+    ComponentMasks();
+    BatchDestruction();
+    BulkSpawn();
+    PagedStorage();
+    StorageTraits();
+    TagComponents();
+    SoAStorage();
+    AdaptiveSparseIndex();
+    PresenceJoin();
+    EntityHandles();
+    EntityRanges();
+    ReservedEntities();
+    PoolHandles();
+    ParallelPoolHandles();
+    StableTypeIds();
+    ResourceConflicts();
+    WorldShutdown();
 
     return 0;
 }
@@ -0,0 +1,196 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/SoA.h"
+#include "FECS/Core/Types.h"
+#include "FECS/Manager/ComponentManager.h"
+#include "FECS/Manager/JobManager.h"
+
+namespace FECS::Builder
+{
+    /// @brief Type-erased base so the ViewManager can own cached queries of any signature.
+    class ICachedQuery
+    {
+    public:
+        virtual ~ICachedQuery() = default;
+    };
+
+    /**
+     * @brief Persistent query remembering which entities matched and where their components live.
+     *
+     * The match list stores, per entity, its dense index in every involved pool.
+     * It is rebuilt lazily when the structural version of one of the pools
+     * changed since the last build, otherwise iterating is a straight walk over
+     * the list without any sparse lookup. Use it for queries running every frame
+     * over pools that rarely gain or lose entities.
+     */
+    template <typename... Components>
+    class CachedQuery : public ICachedQuery
+    {
+    private:
+        template <typename C>
+        using PoolFor = Container::SparseSet<std::remove_const_t<C>>;
+
+        using PoolTuple = std::tuple<PoolFor<Components>*...>;
+
+        static constexpr std::size_t COUNT = sizeof...(Components);
+
+        struct Match
+        {
+            Entity entity;
+            std::array<std::uint32_t, COUNT> dense;
+        };
+
+    public:
+        static constexpr std::size_t DEFAULT_GRAIN_SIZE = 4096;
+
+        CachedQuery(Manager::ComponentManager* manager, Manager::JobManager* jobs = nullptr)
+            : p_JobManager(jobs),
+              m_Pools(std::make_tuple(manager->GetStorages().template GetPool<std::remove_const_t<Components>>()...))
+        {
+            m_Versions.fill(NPOS);
+        }
+
+        CachedQuery(const CachedQuery&) = delete;
+        CachedQuery& operator=(const CachedQuery&) = delete;
+
+        /**
+         * @brief Tick mutably accessed tracked components are stamped with, see Changed.
+         *
+         * Systems set it to the tick of their run, like QueryBuilder. 0 stamps
+         * with the pools' current tick.
+         */
+        auto SetTick(Tick tick) -> void
+        {
+            m_Tick.store(tick, std::memory_order_relaxed);
+        }
+
+        template <typename Func>
+        auto Each(Func&& queryFunction) -> void
+        {
+            Refresh();
+            for (const Match& match : m_Matches)
+            {
+                Visit(match, queryFunction, std::index_sequence_for<Components...>{});
+            }
+        }
+
+        /**
+         * @brief Runs the cached query on the job system, see QueryBuilder::ParallelEach().
+         */
+        template <typename Func>
+        auto ParallelEach(Func&& queryFunction, std::size_t grainSize = DEFAULT_GRAIN_SIZE) -> void
+        {
+            Refresh();
+
+            (std::get<PoolFor<Components>*>(m_Pools)->Lock(), ...);
+            auto run = [&](std::size_t begin, std::size_t end)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    Visit(m_Matches[i], queryFunction, std::index_sequence_for<Components...>{});
+                }
+            };
+
+            try
+            {
+                if (p_JobManager)
+                {
+                    p_JobManager->ParallelFor(m_Matches.size(), grainSize, run);
+                }
+                else
+                {
+                    run(0, m_Matches.size());
+                }
+            }
+            catch (...)
+            {
+                (std::get<PoolFor<Components>*>(m_Pools)->Unlock(), ...);
+                throw;
+            }
+            (std::get<PoolFor<Components>*>(m_Pools)->Unlock(), ...);
+        }
+
+        /// @brief Number of matching entities, rebuilding the cache if needed.
+        auto Size() -> std::size_t
+        {
+            Refresh();
+            return m_Matches.size();
+        }
+
+        /// @brief Rebuilds the match list if any involved pool changed structurally.
+        auto Refresh() -> void
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            std::array<std::uint32_t, COUNT> versions = {std::get<PoolFor<Components>*>(m_Pools)->GetVersion()...};
+            if (versions == m_Versions)
+            {
+                return;
+            }
+
+            Rebuild(std::index_sequence_for<Components...>{});
+            m_Versions = versions;
+        }
+
+    private:
+        template <std::size_t... I>
+        auto Rebuild(std::index_sequence<I...>) -> void
+        {
+            std::array<std::size_t, COUNT> sizes = {std::get<I>(m_Pools)->Size()...};
+
+            std::size_t driver = 0;
+            for (std::size_t i = 1; i < COUNT; ++i)
+            {
+                if (sizes[i] < sizes[driver])
+                {
+                    driver = i;
+                }
+            }
+
+            std::array<fast_vector<Entity>*, COUNT> entities = {&std::get<I>(m_Pools)->GetEntities()...};
+
+            m_Matches.clear();
+            m_Matches.reserve(sizes[driver]);
+            for (Entity e : *entities[driver])
+            {
+                if ((std::get<I>(m_Pools)->Has(e) && ...))
+                {
+                    m_Matches.push_back(Match{e, {std::get<I>(m_Pools)->DenseIndex(e)...}});
+                }
+            }
+        }
+
+        template <typename Func, std::size_t... I>
+        inline auto Visit(const Match& match, Func& queryFunction, std::index_sequence<I...>) -> void
+        {
+            (Touch<I, Components>(match.dense[I]), ...);
+            queryFunction(match.entity, static_cast<ComponentRef<Components>>(std::get<I>(m_Pools)->GetDataVector()[match.dense[I]])...);
+        }
+
+        template <std::size_t I, typename C>
+        inline auto Touch(std::uint32_t dense) -> void
+        {
+            if constexpr (MARKS_CHANGES<C>)
+            {
+                Tick tick = m_Tick.load(std::memory_order_relaxed);
+                std::get<I>(m_Pools)->MarkChanged(dense, tick != 0 ? tick : std::get<I>(m_Pools)->CurrentTick());
+            }
+        }
+
+        Manager::JobManager* p_JobManager;
+        PoolTuple m_Pools;
+        std::array<std::uint32_t, COUNT> m_Versions;
+        std::vector<Match> m_Matches;
+        std::mutex m_Mutex;
+        std::atomic<Tick> m_Tick = 0; ///< Atomic, read-only systems sharing the query may set it concurrently
+    };
+}
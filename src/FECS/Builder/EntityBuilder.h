@@ -3,6 +3,7 @@
 #include "FECS/Manager/ComponentManager.h"
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 namespace FECS::Builder
 {
@@ -41,13 +42,21 @@ namespace FECS::Builder
             return *this;
         }
 
+        /// @brief Attaches the empty component T, which costs an entity list entry but no component value.
         template <typename T>
-        inline auto Tag(const T& component) -> EntityBuilder&
+        inline auto Tag() -> EntityBuilder&
         {
+            static_assert(std::is_empty_v<T>, "Tags must be empty types, use Attach() for components with data");
             p_ComponentManager->Attach<T>(m_ModifiedEntity, T{});
             return *this;
         }
 
+        template <typename T>
+        inline auto Tag(const T&) -> EntityBuilder&
+        {
+            return Tag<T>();
+        }
+
         template <typename T>
         inline auto Detach() -> EntityBuilder&
         {
@@ -75,8 +84,19 @@ namespace FECS::Builder
         template <typename T>
         inline auto Patch(std::function<void(T&)> func) -> EntityBuilder&
         {
-            T& component = p_ComponentManager->Get<T>(m_ModifiedEntity);
-            func(component);
+            if constexpr (IS_SOA_COMPONENT<T>)
+            {
+                // The fields are gathered into a T for the callback and scattered back
+                SoARef<T> fields = p_ComponentManager->Get<T>(m_ModifiedEntity);
+                T component = fields;
+                func(component);
+                fields = component;
+            }
+            else
+            {
+                T& component = p_ComponentManager->Get<T>(m_ModifiedEntity);
+                func(component);
+            }
             return *this;
         }
 
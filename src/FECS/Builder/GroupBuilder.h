@@ -0,0 +1,157 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "FECS/Containers/OwningGroup.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/SoA.h"
+#include "FECS/Core/Types.h"
+#include "FECS/Manager/ComponentManager.h"
+#include "FECS/Manager/JobManager.h"
+
+namespace FECS::Builder
+{
+    /**
+     * @brief Query over an owning group, iterating the owned dense arrays in lockstep.
+     *
+     * Const components share the group of their mutable type and are handed
+     * out as const references, like in QueryBuilder.
+     */
+    template <typename... Components>
+    class GroupBuilder
+    {
+    private:
+        using Group = Container::GroupOf<std::remove_const_t<Components>...>;
+
+    public:
+        static constexpr std::size_t DEFAULT_GRAIN_SIZE = 4096;
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024;
+
+        GroupBuilder(Manager::ComponentManager* manager, Manager::JobManager* jobs = nullptr)
+            : GroupBuilder(manager, jobs, manager->GetStorages().CurrentTick())
+        {
+        }
+
+        /// @param tick Tick mutably accessed tracked components are stamped with, see Changed.
+        GroupBuilder(Manager::ComponentManager* manager, Manager::JobManager* jobs, Tick tick)
+            : p_JobManager(jobs),
+              p_Group(manager->GetStorages().template GetGroup<std::remove_const_t<Components>...>()),
+              m_Tick(tick)
+        {
+        }
+
+        template <typename Func>
+        auto Each(Func&& queryFunction) -> void
+        {
+            Walk(0, p_Group->Size(), queryFunction);
+        }
+
+        /**
+         * @brief Hands out the group in blocks of contiguous arrays, see QueryBuilder::EachChunk().
+         *
+         * The pointers point straight into the owned pools. Blocks of paged pools
+         * end at their block boundaries, so blocks may be shorter than blockSize.
+         */
+        template <typename Func>
+        auto EachChunk(Func&& chunkFunction, std::size_t blockSize = DEFAULT_BLOCK_SIZE) -> void
+        {
+            blockSize = std::max<std::size_t>(blockSize, 1);
+
+            const Entity* entities = p_Group->GetEntities().data();
+            for (std::size_t begin = 0; begin < p_Group->Size();)
+            {
+                std::size_t count = std::min({blockSize, p_Group->Size() - begin, PoolOf<Components>()->ContiguousRun(begin)...});
+                (Touch<Components>(begin, begin + count), ...);
+                chunkFunction(count, entities + begin, static_cast<ComponentPtr<Components>>(&PoolOf<Components>()->GetDataVector()[begin])...);
+                begin += count;
+            }
+        }
+
+        /**
+         * @brief Runs the group on the job system, see QueryBuilder::ParallelEach().
+         */
+        template <typename Func>
+        auto ParallelEach(Func&& queryFunction, std::size_t grainSize = DEFAULT_GRAIN_SIZE) -> void
+        {
+            PoolLock lock(p_Group);
+            if (p_JobManager)
+            {
+                p_JobManager->ParallelFor(p_Group->Size(), grainSize, [&](std::size_t begin, std::size_t end)
+                {
+                    Walk(begin, end, queryFunction);
+                });
+            }
+            else
+            {
+                Walk(0, p_Group->Size(), queryFunction);
+            }
+        }
+
+        auto Size() const -> std::size_t
+        {
+            return p_Group->Size();
+        }
+
+    private:
+        struct PoolLock
+        {
+            explicit PoolLock(Group* group)
+                : group(group)
+            {
+                (group->template GetPool<std::remove_const_t<Components>>()->Lock(), ...);
+            }
+
+            ~PoolLock()
+            {
+                (group->template GetPool<std::remove_const_t<Components>>()->Unlock(), ...);
+            }
+
+            Group* group;
+        };
+
+        template <typename C>
+        inline auto PoolOf() -> Container::SparseSet<std::remove_const_t<C>>*
+        {
+            return p_Group->template GetPool<std::remove_const_t<C>>();
+        }
+
+        template <typename Func>
+        inline auto Walk(std::size_t begin, std::size_t end, Func& queryFunction) -> void
+        {
+            Walk(begin, end, queryFunction, std::index_sequence_for<Components...>{});
+        }
+
+        template <typename Func, std::size_t... I>
+        inline auto Walk(std::size_t begin, std::size_t end, Func& queryFunction, std::index_sequence<I...>) -> void
+        {
+            Entity* entities = p_Group->GetEntities().data();
+            auto data = std::make_tuple(PoolOf<Components>()->GetDenseView()...);
+
+            (Touch<Components>(begin, end), ...);
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                queryFunction(entities[i], static_cast<ComponentRef<Components>>(std::get<I>(data)[i])...);
+            }
+        }
+
+        /// @brief Stamps [begin, end) of the pool of C as changed when C is handed out mutably.
+        template <typename C>
+        inline auto Touch(std::size_t begin, std::size_t end) -> void
+        {
+            if constexpr (MARKS_CHANGES<C>)
+            {
+                auto* pool = PoolOf<C>();
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    pool->MarkChanged(static_cast<std::uint32_t>(i), m_Tick);
+                }
+            }
+        }
+
+        Manager::JobManager* p_JobManager;
+        Group* p_Group;
+        Tick m_Tick;
+    };
+}
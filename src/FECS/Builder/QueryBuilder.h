@@ -1,26 +1,111 @@
 #pragma once
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "FECS/Containers/ArchetypeStorage.h"
+#include "FECS/Containers/PoolHandle.h"
 #include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/QueryFilters.h"
+#include "FECS/Core/Reduce.h"
+#include "FECS/Core/SoA.h"
 #include "FECS/Core/Types.h"
+#include "FECS/Internal/QueryTerm.h"
 #include "FECS/Manager/ComponentManager.h"
+#include "FECS/Manager/JobManager.h"
 
 namespace FECS::Builder
 {
+    /**
+     * @brief Joins components and filters, see Internal::QueryTerm.
+     *
+     * Plain components are required and passed by reference, const components
+     * are handed out as const references. Optional<T> is passed as a pointer,
+     * Without<Ts...> and AnyOf<Ts...> only filter. The callback receives the
+     * entity followed by the passed terms in declaration order.
+     */
     template <typename... Components>
     class QueryBuilder
     {
     private:
-        struct PoolInfo
+        template <typename C>
+        using Term = Internal::QueryTerm<C>;
+
+        using Terms = std::tuple<Term<Components>...>;
+
+        template <std::size_t I>
+        using TermAt = std::tuple_element_t<I, Terms>;
+
+        static constexpr std::size_t COUNT = sizeof...(Components);
+
+        static_assert((Term<Components>::REQUIRED || ...), "A query needs at least one required component");
+
+        /// @brief Whether term I is a pooled required component, whose dense indices the batched join resolves up front.
+        template <std::size_t I>
+        static constexpr bool RESOLVED = TermAt<I>::REQUIRED && !TermAt<I>::IN_TABLE;
+
+        /// @brief Whether the join is driven by archetype tables rather than by the smallest pool.
+        static constexpr bool USES_TABLES = ((Term<Components>::REQUIRED && Term<Components>::IN_TABLE) || ...);
+
+        /// @brief Whether every term is a plain component, so storage can be handed out as is.
+        static constexpr bool ALL_PLAIN = (Term<Components>::PLAIN && ...);
+
+        /// @brief Whether every component lives in tables, so table chunks can be handed out as is.
+        static constexpr bool ONLY_TABLES = ALL_PLAIN && (Term<Components>::IN_TABLE && ...);
+
+        /// @brief Index of the first required term with a presence bitmap, COUNT if none.
+        static constexpr auto AnchorTerm() -> std::size_t
+        {
+            std::size_t index = 0;
+            std::size_t found = COUNT;
+            ((found == COUNT && Term<Components>::REQUIRED && Term<Components>::MASKED ? found = index : 0, ++index), ...);
+            return found;
+        }
+
+        /// @brief Required term whose pool maps the indices found by the presence join back to entities.
+        static constexpr std::size_t ANCHOR = AnchorTerm();
+
+        /// @brief Whether the pool-driven join can intersect presence bitmaps word by word, which takes two masked terms.
+        static constexpr bool PRESENCE_JOIN = !USES_TABLES && ANCHOR < COUNT && (std::size_t(Term<Components>::MASKED) + ...) >= 2;
+
+        /// @brief A chunk of a matching table, with the per-table value of every term.
+        struct TableChunk
         {
-            size_t size;
-            fast_vector<Entity>* entities;
+            Container::ArchetypeTable* table;
+            std::size_t chunk;
+            std::array<std::uint32_t, COUNT> columns;
         };
 
     public:
-        QueryBuilder(Manager::ComponentManager* manager)
+        /// @brief Candidates whose dense indices are resolved, filtered and prefetched together, see Join().
+        static constexpr std::size_t JOIN_BLOCK_SIZE = 128;
+
+        /// @brief Presence words intersected before the matching entities of the block are visited.
+        static constexpr std::size_t PRESENCE_BLOCK_WORDS = 16;
+
+        /// @brief Number of driving entities handed to a worker at once by the parallel iterations.
+        static constexpr std::size_t DEFAULT_GRAIN_SIZE = 4096;
+
+        /// @brief Maximum number of entities per block handed out by EachChunk.
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024;
+
+        /// @brief Query outside of a system, every tracked component counts as changed.
+        QueryBuilder(Manager::ComponentManager* manager, Manager::JobManager* jobs = nullptr)
+            : QueryBuilder(manager, jobs, TickRange{0, manager->GetStorages().CurrentTick()})
+        {
+        }
+
+        /// @param ticks Change detection window of the running system, see Added and Changed.
+        QueryBuilder(Manager::ComponentManager* manager, Manager::JobManager* jobs, TickRange ticks)
             : p_ComponentManager(manager),
-              m_Pools(std::make_tuple(manager->GetStorages().template GetPool<Components>()...))
+              p_JobManager(jobs),
+              m_Terms(Term<Components>(manager->GetStorages(), ticks)...)
         {
         }
         ~QueryBuilder() = default;
@@ -28,33 +113,649 @@ namespace FECS::Builder
         template <typename Func>
         auto Each(Func&& queryFunction) -> void
         {
-            std::array<PoolInfo, sizeof...(Components)> info = {
-                PoolInfo{
-                    std::get<Container::SparseSet<Components>*>(m_Pools)->Size(),
-                    &std::get<Container::SparseSet<Components>*>(m_Pools)->GetEntities()}...};
+            if constexpr (USES_TABLES)
+            {
+                for (const TableChunk& chunk : MatchingChunks())
+                {
+                    VisitChunk(chunk, queryFunction, std::index_sequence_for<Components...>{});
+                }
+            }
+            else
+            {
+                fast_vector<Entity>& entities = DrivingEntities();
+                if constexpr (PRESENCE_JOIN)
+                {
+                    // Scanning the bitmaps pays off once they aren't much longer than the driving pool
+                    std::size_t words = PresenceWords(std::index_sequence_for<Components...>{});
+                    if (words <= entities.size())
+                    {
+                        PresenceJoin(words, queryFunction);
+                        return;
+                    }
+                }
 
-            const PoolInfo* smallest = &info[0];
-            for (const auto& item : info)
+                Join(entities.data(), entities.size(), queryFunction);
+            }
+        }
+
+        /**
+         * @brief Iterates the matches in blocks of contiguous arrays.
+         *
+         * The callback is invoked as (std::size_t count, const Entity* entities,
+         * Components*... data), where data[i] belongs to entities[i]. Single
+         * component queries and queries made only of table components point
+         * straight into the storage, a single SoA component is handed out as a
+         * SoAPtr exposing one array per field. Other queries gather the matches into
+         * temporary blocks and write the non-const components back after the
+         * callback returned, so pointers must not be kept beyond the call.
+         */
+        template <typename Func>
+        auto EachChunk(Func&& chunkFunction, std::size_t blockSize = DEFAULT_BLOCK_SIZE) -> void
+        {
+            static_assert(((Term<Components>::PASSED == Term<Components>::REQUIRED) && ...), "EachChunk doesn't support Optional terms");
+            blockSize = std::max<std::size_t>(blockSize, 1);
+
+            if constexpr (ONLY_TABLES)
+            {
+                for (const TableChunk& chunk : MatchingChunks())
+                {
+                    HandChunk(chunk, chunkFunction, std::index_sequence_for<Components...>{});
+                }
+            }
+            else if constexpr (COUNT == 1 && ALL_PLAIN && !USES_TABLES)
             {
-                if (item.size < smallest->size)
+                using C = std::tuple_element_t<0, std::tuple<Components...>>;
+                auto* pool = std::get<0>(m_Terms).storage;
+                const Entity* entities = pool->GetEntities().data();
+                for (std::size_t begin = 0; begin < pool->Size();)
                 {
-                    smallest = &item;
+                    // Paged pools are only contiguous up to their block boundaries
+                    std::size_t count = std::min(blockSize, pool->ContiguousRun(begin));
+                    if constexpr (MARKS_CHANGES<C>)
+                    {
+                        for (std::size_t i = begin; i < begin + count; ++i)
+                        {
+                            pool->MarkChanged(static_cast<std::uint32_t>(i), std::get<0>(m_Terms).ticks.thisRun);
+                        }
+                    }
+                    chunkFunction(count, entities + begin, static_cast<ComponentPtr<C>>(&pool->GetDataVector()[begin]));
+                    begin += count;
                 }
             }
+            else
+            {
+                static_assert(!(IS_SOA_COMPONENT<Components> || ...), "SoA components can only be chunk-iterated in single component queries");
+
+                GatheredBlock<PassedComponents> block(blockSize);
+                Each([&](Entity e, auto&... components)
+                {
+                    block.Push(e, components...);
+                    if (block.Size() == blockSize)
+                    {
+                        block.Flush(chunkFunction);
+                    }
+                });
+                block.Flush(chunkFunction);
+            }
+        }
 
-            for (Entity e : *smallest->entities)
+        /**
+         * @brief Runs the query on the World's job system, chunking the driving pool by grainSize.
+         *
+         * The callback is invoked concurrently and must only touch the components it
+         * is given. The involved pools are locked against structural changes for the
+         * duration of the call.
+         */
+        template <typename Func>
+        auto ParallelEach(Func&& queryFunction, std::size_t grainSize = DEFAULT_GRAIN_SIZE) -> void
+        {
+            PoolLock lock(m_Terms);
+            if constexpr (USES_TABLES)
+            {
+                std::vector<TableChunk> chunks = MatchingChunks();
+                ForChunks(chunks.size(), ChunkGrain(chunks, grainSize), [&](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        VisitChunk(chunks[i], queryFunction, std::index_sequence_for<Components...>{});
+                    }
+                });
+            }
+            else
             {
-                if ((std::get<Container::SparseSet<Components>*>(m_Pools)->Has(e) && ...))
+                fast_vector<Entity>& entities = DrivingEntities();
+                ForChunks(entities.size(), grainSize, [&](std::size_t begin, std::size_t end)
                 {
-                    queryFunction(e, std::get<Container::SparseSet<Components>*>(m_Pools)->Get(e)...);
+                    Join(entities.data() + begin, end - begin, queryFunction);
+                });
+            }
+        }
+
+        /**
+         * @brief Maps every match to a value and folds them in parallel.
+         *
+         * Each chunk accumulates into its own partial result starting from identity,
+         * partials are then combined in chunk order so the result is deterministic
+         * for a given grain size.
+         *
+         * @param identity The neutral value of combine (0 for FECS::Reduce::Sum).
+         * @param mapFunction Called like the Each callback and returns a T.
+         * @param combine Merges two T, e.g. FECS::Reduce::Sum, Min or Max.
+         */
+        template <typename T, typename MapFunc, typename CombineFunc>
+        auto ParallelReduce(T identity, MapFunc&& mapFunction, CombineFunc&& combine, std::size_t grainSize = DEFAULT_GRAIN_SIZE) -> T
+        {
+            std::vector<T> partials;
+
+            {
+                PoolLock lock(m_Terms);
+                auto reduceRange = [&](std::size_t count, std::size_t grain, auto&& visitRange)
+                {
+                    grain = std::max<std::size_t>(grain, 1);
+                    partials.assign((count + grain - 1) / grain, identity);
+                    ForChunks(count, grain, [&](std::size_t begin, std::size_t end)
+                    {
+                        T accumulator = identity;
+                        auto accumulate = [&](Entity e, auto&&... components)
+                        {
+                            accumulator = combine(accumulator, mapFunction(e, components...));
+                        };
+                        visitRange(begin, end, accumulate);
+                        partials[begin / grain] = accumulator;
+                    });
+                };
+
+                if constexpr (USES_TABLES)
+                {
+                    std::vector<TableChunk> chunks = MatchingChunks();
+                    reduceRange(chunks.size(), ChunkGrain(chunks, grainSize), [&](std::size_t begin, std::size_t end, auto& accumulate)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            VisitChunk(chunks[i], accumulate, std::index_sequence_for<Components...>{});
+                        }
+                    });
+                }
+                else
+                {
+                    fast_vector<Entity>& entities = DrivingEntities();
+                    reduceRange(entities.size(), grainSize, [&](std::size_t begin, std::size_t end, auto& accumulate)
+                    {
+                        Join(entities.data() + begin, end - begin, accumulate);
+                    });
                 }
             }
+
+            T result = identity;
+            for (const T& partial : partials)
+            {
+                result = combine(result, partial);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Lookup only handle to the pool of C, for lookups on other entities from inside the callback.
+         *
+         * Reuses the pool the query already bound when C is one of its
+         * required components, so nothing is looked up per entity:
+         * @code
+         * auto parents = query.Pool<const Transform>();
+         * query.Each([&](FECS::Entity id, Transform& transform, const Parent& parent)
+         * {
+         *     transform.world = parents.Get(parent.entity).world * transform.local;
+         * });
+         * @endcode
+         */
+        template <typename C>
+        auto Pool() const -> Container::PoolHandle<C, false>
+        {
+            constexpr std::size_t I = TermOf<C>();
+            if constexpr (I < COUNT)
+            {
+                static_assert(std::is_const_v<C> || !std::is_const_v<std::tuple_element_t<I, std::tuple<Components...>>>, "The query only reads this component, ask for a const handle");
+                return Container::PoolHandle<C, false>(std::get<I>(m_Terms).storage);
+            }
+            else
+            {
+                return p_ComponentManager->template Pool<C>();
+            }
         }
 
     private:
-        using PoolTuple = std::tuple<Container::SparseSet<Components>*...>;
+        /// @brief Index of the required pooled term of C, COUNT if the query has none.
+        template <typename C>
+        static constexpr auto TermOf() -> std::size_t
+        {
+            std::size_t index = 0;
+            std::size_t found = COUNT;
+            ((found == COUNT && Term<Components>::PLAIN && Term<Components>::REQUIRED && !Term<Components>::IN_TABLE &&
+                      std::is_same_v<std::remove_const_t<Components>, std::remove_const_t<C>>
+                  ? found = index
+                  : 0,
+              ++index),
+             ...);
+            return found;
+        }
+
+        /// @brief The components handed out by required terms, in order.
+        using PassedComponents = decltype(std::tuple_cat(
+            std::declval<std::conditional_t<Term<Components>::REQUIRED, std::tuple<Components>, std::tuple<>>>()...));
+
+        /// @brief Locks the storages of every term against structural changes for the lifetime of the guard.
+        struct PoolLock
+        {
+            explicit PoolLock(Terms& terms)
+                : terms(terms)
+            {
+                std::apply([](auto&... term)
+                {
+                    (term.Lock(), ...);
+                }, terms);
+            }
+
+            ~PoolLock()
+            {
+                std::apply([](auto&... term)
+                {
+                    (term.Unlock(), ...);
+                }, terms);
+            }
+
+            Terms& terms;
+        };
+
+        /// @brief Picks the smallest required pool to drive the join, filters and optional terms never drive.
+        auto DrivingEntities() -> fast_vector<Entity>&
+        {
+            fast_vector<Entity>* driving = nullptr;
+            std::size_t smallest = std::numeric_limits<std::size_t>::max();
+
+            std::apply([&](auto&... term)
+            {
+                auto consider = [&](auto& candidate)
+                {
+                    using Candidate = std::remove_reference_t<decltype(candidate)>;
+                    if constexpr (Candidate::REQUIRED && !Candidate::IN_TABLE)
+                    {
+                        if (candidate.storage->Size() < smallest)
+                        {
+                            smallest = candidate.storage->Size();
+                            driving = &candidate.storage->GetEntities();
+                        }
+                    }
+                };
+                (consider(term), ...);
+            }, m_Terms);
+
+            return *driving;
+        }
+
+        /// @brief Words past which some required bitmap is empty, so no index beyond can match.
+        template <std::size_t... I>
+        auto PresenceWords(std::index_sequence<I...>) const -> std::size_t
+        {
+            return std::min({std::numeric_limits<std::size_t>::max(), MaskWords<I>()...});
+        }
+
+        template <std::size_t I>
+        auto MaskWords() const -> std::size_t
+        {
+            if constexpr (TermAt<I>::REQUIRED && TermAt<I>::MASKED)
+            {
+                return std::get<I>(m_Terms).MaskWords();
+            }
+            else
+            {
+                return std::numeric_limits<std::size_t>::max();
+            }
+        }
+
+        template <std::size_t... I>
+        inline auto Mask(std::size_t word, std::index_sequence<I...>) const -> Internal::PresenceWord
+        {
+            return (std::get<I>(m_Terms).Mask(word) & ...);
+        }
+
+        /**
+         * @brief Visits the matches in entity index order, rejecting 64 indices per AND of the term masks.
+         *
+         * Candidates surviving a block of masks are collected first, only they
+         * reach the sparse pages and the component data through Join().
+         */
+        template <typename Func>
+        auto PresenceJoin(std::size_t words, Func& queryFunction) -> void
+        {
+            constexpr std::size_t WORD_BITS = Container::PresenceBitmap::WORD_BITS;
+            std::array<Entity, PRESENCE_BLOCK_WORDS * WORD_BITS> candidates;
+            auto* anchor = std::get<ANCHOR>(m_Terms).storage;
+
+            for (std::size_t block = 0; block < words; block += PRESENCE_BLOCK_WORDS)
+            {
+                std::size_t count = 0;
+                std::size_t last = std::min(block + PRESENCE_BLOCK_WORDS, words);
+                for (std::size_t w = block; w < last; ++w)
+                {
+                    Internal::PresenceWord bits = Mask(w, std::index_sequence_for<Components...>{});
+                    while (bits)
+                    {
+                        candidates[count++] = anchor->EntityOf(static_cast<std::uint32_t>(w * WORD_BITS + std::countr_zero(bits)));
+                        bits &= bits - 1;
+                    }
+                }
+
+                Join(candidates.data(), count, queryFunction);
+            }
+        }
+
+        /// @brief Survivors of a block of the join, with the dense index of every pooled required term.
+        struct JoinBlock
+        {
+            std::array<Entity, JOIN_BLOCK_SIZE> entities;
+            std::array<std::array<std::uint32_t, JOIN_BLOCK_SIZE>, COUNT> slots;
+            std::size_t size = 0;
+        };
+
+        /**
+         * @brief Runs the join over a list of candidate entities, JOIN_BLOCK_SIZE at a time.
+         *
+         * Each block is first screened by presence bitmaps and filter terms into
+         * a selection, then the dense indices of every pooled required term are
+         * resolved for the whole selection in one pass per pool (gathered with
+         * AVX2 where available). Pools without a bitmap drop their misses from
+         * the selection at that point. The components of the survivors are
+         * prefetched before the callback runs over them.
+         */
+        template <typename Func>
+        auto Join(const Entity* entities, std::size_t count, Func& queryFunction) -> void
+        {
+            Join(entities, count, queryFunction, std::index_sequence_for<Components...>{});
+        }
+
+        template <typename Func, std::size_t... I>
+        auto Join(const Entity* entities, std::size_t count, Func& queryFunction, std::index_sequence<I...>) -> void
+        {
+            JoinBlock block;
+            for (std::size_t begin = 0; begin < count; begin += JOIN_BLOCK_SIZE)
+            {
+                std::size_t end = std::min(begin + JOIN_BLOCK_SIZE, count);
+                block.size = 0;
+                for (std::size_t k = begin; k < end; ++k)
+                {
+                    block.entities[block.size] = entities[k];
+                    block.size += (Screen<I>(entities[k]) && ...);
+                }
 
-        PoolTuple m_Pools;
+                (Resolve<I>(block), ...);
+
+                for (std::size_t k = 0; k < block.size; ++k)
+                {
+                    (Prefetch<I>(block.slots[I][k]), ...);
+                }
+
+                for (std::size_t k = 0; k < block.size; ++k)
+                {
+                    Entity e = block.entities[k];
+                    std::apply(queryFunction, std::tuple_cat(std::tuple<Entity>(e), PassDense<I>(e, block.slots[I][k])...));
+                }
+            }
+        }
+
+        /// @brief Cheap test before any sparse page is read, presence bits for pooled required terms.
+        template <std::size_t I>
+        inline auto Screen(Entity e) const -> bool
+        {
+            if constexpr (RESOLVED<I> && !TermAt<I>::MASKED)
+            {
+                // Only known once the slot is resolved
+                return true;
+            }
+            else
+            {
+                return std::get<I>(m_Terms).AcceptEntity(e);
+            }
+        }
+
+        template <std::size_t I>
+        inline auto Resolve(JoinBlock& block) const -> void
+        {
+            if constexpr (RESOLVED<I>)
+            {
+                std::uint32_t* slots = block.slots[I].data();
+                std::get<I>(m_Terms).Resolve(block.entities.data(), block.size, slots);
+
+                if constexpr (!TermAt<I>::MASKED)
+                {
+                    Compact<I>(block, std::index_sequence_for<Components...>{});
+                }
+            }
+        }
+
+        /// @brief Drops the entities term I missed, moving the slots resolved so far along.
+        template <std::size_t I, std::size_t... J>
+        inline auto Compact(JoinBlock& block, std::index_sequence<J...>) const -> void
+        {
+            std::size_t kept = 0;
+            for (std::size_t k = 0; k < block.size; ++k)
+            {
+                bool hit = block.slots[I][k] != NPOS;
+                block.entities[kept] = block.entities[k];
+                ((J <= I && RESOLVED<J> ? block.slots[J][kept] = block.slots[J][k] : 0), ...);
+                kept += hit;
+            }
+            block.size = kept;
+        }
+
+        template <std::size_t I>
+        inline auto Prefetch(std::uint32_t dense) const -> void
+        {
+            if constexpr (RESOLVED<I>)
+            {
+                std::get<I>(m_Terms).Prefetch(dense);
+            }
+        }
+
+        template <std::size_t I>
+        inline auto PassDense(Entity e, std::uint32_t dense) -> decltype(auto)
+        {
+            if constexpr (RESOLVED<I>)
+            {
+                return std::tuple<typename TermAt<I>::Argument>(std::get<I>(m_Terms).FetchDense(dense));
+            }
+            else if constexpr (TermAt<I>::PASSED)
+            {
+                return std::tuple<typename TermAt<I>::Argument>(std::get<I>(m_Terms).FetchEntity(e));
+            }
+            else
+            {
+                return std::tuple<>();
+            }
+        }
+
+        template <std::size_t I>
+        inline auto PassRow(Entity e, void* data, std::uint32_t row) -> decltype(auto)
+        {
+            if constexpr (TermAt<I>::PASSED)
+            {
+                return std::tuple<typename TermAt<I>::Argument>(std::get<I>(m_Terms).FetchRow(e, data, row));
+            }
+            else
+            {
+                return std::tuple<>();
+            }
+        }
+
+        /// @brief Collects the non-empty chunks of every table accepted by all terms.
+        auto MatchingChunks() -> std::vector<TableChunk>
+        {
+            std::vector<TableChunk> chunks;
+            for (const auto& table : p_ComponentManager->GetStorages().GetArchetypes().GetTables())
+            {
+                TableChunk match{table.get(), 0, {}};
+                if (!AcceptTable(*table, match.columns, std::index_sequence_for<Components...>{}))
+                {
+                    continue;
+                }
+
+                for (std::size_t c = 0; c < table->ChunkCount(); ++c)
+                {
+                    match.chunk = c;
+                    chunks.push_back(match);
+                }
+            }
+            return chunks;
+        }
+
+        template <std::size_t... I>
+        auto AcceptTable(const Container::ArchetypeTable& table, std::array<std::uint32_t, COUNT>& columns, std::index_sequence<I...>) -> bool
+        {
+            return (std::get<I>(m_Terms).AcceptTable(table, columns[I]) && ...);
+        }
+
+        /// @brief Converts a grain size in entities to a number of chunks.
+        static auto ChunkGrain(const std::vector<TableChunk>& chunks, std::size_t grainSize) -> std::size_t
+        {
+            if (chunks.empty())
+            {
+                return 1;
+            }
+
+            std::size_t rows = 0;
+            for (const TableChunk& chunk : chunks)
+            {
+                rows += chunk.table->ChunkSize(chunk.chunk);
+            }
+            std::size_t rowsPerChunk = std::max<std::size_t>(rows / chunks.size(), 1);
+            return std::max<std::size_t>(grainSize / rowsPerChunk, 1);
+        }
+
+        template <typename Func, std::size_t... I>
+        inline auto VisitChunk(const TableChunk& chunk, Func& queryFunction, std::index_sequence<I...>) -> void
+        {
+            Entity* entities = chunk.table->Entities(chunk.chunk);
+            std::array<void*, COUNT> data = {std::get<I>(m_Terms).ColumnData(*chunk.table, chunk.chunk, chunk.columns[I])...};
+
+            std::uint32_t rows = chunk.table->ChunkSize(chunk.chunk);
+            for (std::uint32_t row = 0; row < rows; ++row)
+            {
+                Entity e = entities[row];
+                if ((std::get<I>(m_Terms).AcceptRow(e, chunk.columns[I]) && ...))
+                {
+                    std::apply(queryFunction, std::tuple_cat(std::tuple<Entity>(e), PassRow<I>(e, data[I], row)...));
+                }
+            }
+        }
+
+        template <typename Func, std::size_t... I>
+        inline auto HandChunk(const TableChunk& chunk, Func& chunkFunction, std::index_sequence<I...>) -> void
+        {
+            chunkFunction(
+                static_cast<std::size_t>(chunk.table->ChunkSize(chunk.chunk)),
+                static_cast<const Entity*>(chunk.table->Entities(chunk.chunk)),
+                static_cast<std::tuple_element_t<I, std::tuple<Components...>>*>(
+                    std::get<I>(m_Terms).ColumnData(*chunk.table, chunk.chunk, chunk.columns[I]))...);
+        }
+
+        /**
+         * @brief Copies of up to a block of matches, used when the storage isn't contiguous.
+         */
+        template <typename List>
+        class GatheredBlock;
+
+        template <typename... Passed>
+        class GatheredBlock<std::tuple<Passed...>>
+        {
+        public:
+            explicit GatheredBlock(std::size_t capacity)
+            {
+                m_Entities.reserve(capacity);
+                std::apply([capacity](auto&... values)
+                {
+                    (values.reserve(capacity), ...);
+                }, m_Values);
+                std::apply([capacity](auto&... sources)
+                {
+                    (sources.reserve(capacity), ...);
+                }, m_Sources);
+            }
+
+            auto Size() const -> std::size_t
+            {
+                return m_Entities.size();
+            }
+
+            auto Push(Entity e, Passed&... components) -> void
+            {
+                Push(e, std::index_sequence_for<Passed...>{}, components...);
+            }
+
+            /// @brief Hands the block to the callback, then writes the mutable components back.
+            template <typename Func>
+            auto Flush(Func& chunkFunction) -> void
+            {
+                Flush(chunkFunction, std::index_sequence_for<Passed...>{});
+            }
+
+        private:
+            template <std::size_t... I>
+            auto Push(Entity e, std::index_sequence<I...>, Passed&... components) -> void
+            {
+                m_Entities.push_back(e);
+                (std::get<I>(m_Values).push_back(components), ...);
+                (std::get<I>(m_Sources).push_back(&components), ...);
+            }
+
+            template <typename Func, std::size_t... I>
+            auto Flush(Func& chunkFunction, std::index_sequence<I...>) -> void
+            {
+                if (m_Entities.empty())
+                {
+                    return;
+                }
+
+                chunkFunction(m_Entities.size(), static_cast<const Entity*>(m_Entities.data()), static_cast<Passed*>(std::get<I>(m_Values).data())...);
+                (ScatterBack<I>(), ...);
+
+                m_Entities.clear();
+                (std::get<I>(m_Values).clear(), ...);
+                (std::get<I>(m_Sources).clear(), ...);
+            }
+
+            template <std::size_t I>
+            auto ScatterBack() -> void
+            {
+                if constexpr (!std::is_const_v<std::tuple_element_t<I, std::tuple<Passed...>>>)
+                {
+                    auto& values = std::get<I>(m_Values);
+                    auto& sources = std::get<I>(m_Sources);
+                    for (std::size_t k = 0; k < values.size(); ++k)
+                    {
+                        *sources[k] = std::move(values[k]);
+                    }
+                }
+            }
+
+            std::vector<Entity> m_Entities;
+            std::tuple<std::vector<std::remove_const_t<Passed>>...> m_Values;
+            std::tuple<std::vector<Passed*>...> m_Sources;
+        };
+
+        template <typename Func>
+        auto ForChunks(std::size_t count, std::size_t grainSize, Func&& func) -> void
+        {
+            if (p_JobManager)
+            {
+                p_JobManager->ParallelFor(count, grainSize, func);
+            }
+            else
+            {
+                func(std::size_t(0), count);
+            }
+        }
+
+    private:
         Manager::ComponentManager* p_ComponentManager;
+        Manager::JobManager* p_JobManager;
+        Terms m_Terms;
     };
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include "FECS/Builder/CachedQuery.h"
+#include "FECS/Builder/GroupBuilder.h"
 #include "FECS/Builder/QueryBuilder.h"
 #include "FECS/Internal/SystemResolver.h"
 #include "FECS/World.h"
@@ -50,6 +52,52 @@ namespace FECS::Builder
             return next;
         }
 
+        template <typename ... Comps>
+        auto WithGroup() -> SystemBuilder<Args..., GroupBuilder<Comps...> >
+        {
+            auto next = SystemBuilder<Args..., GroupBuilder<Comps...> >(m_World, m_ScheduleManager);
+            CopyStateTo(next);
+            return next;
+        }
+
+        /**
+         * @brief Passes the World's persistent CachedQuery for these components to the system.
+         */
+        template <typename ... Comps>
+        auto WithCachedQuery() -> SystemBuilder<Args..., CachedQuery<Comps...>&>
+        {
+            auto next = SystemBuilder<Args..., CachedQuery<Comps...>&>(m_World, m_ScheduleManager);
+            CopyStateTo(next);
+            return next;
+        }
+
+        /**
+         * @brief Passes a lookup only PoolHandle of T to the system, for direct lookups on arbitrary entities.
+         *
+         * A const T is declared as a read, anything else as a write of the
+         * components' values. Inserting or removing goes through WithCommands().
+         */
+        template <typename T>
+        auto WithPool() -> SystemBuilder<Args..., Container::PoolHandle<T, false> >
+        {
+            auto next = SystemBuilder<Args..., Container::PoolHandle<T, false> >(m_World, m_ScheduleManager);
+            CopyStateTo(next);
+            return next;
+        }
+
+        /**
+         * @brief Passes the system a recorder into the calling thread's CommandBuffer.
+         *
+         * Recorded commands are played back after the system's set finished.
+         * It may be captured into ParallelEach(), see Manager::SystemCommands.
+         */
+        auto WithCommands() -> SystemBuilder<Args..., Manager::SystemCommands&>
+        {
+            auto next = SystemBuilder<Args..., Manager::SystemCommands&>(m_World, m_ScheduleManager);
+            CopyStateTo(next);
+            return next;
+        }
+
         auto In(uint16_t setIndex) -> SystemBuilder<Args...>&
         {
             m_SetIndex = setIndex;
@@ -108,12 +156,18 @@ namespace FECS::Builder
         template <typename Fn>
         auto Build(Fn&& func) -> void
         {
-            auto task = [func](World& world)
+            Internal::SystemAccess access;
+            Internal::SystemState initial;
+            (Internal::Resolver<Args>::Declare(m_World, access, initial), ...);
+
+            auto task = [func, state = std::move(initial)](World& world) mutable
                         {
-                            func(Internal::Resolver<Args>::Get(world)...);
+                            state.ticks.thisRun = world.Components().GetStorages().AdvanceTick();
+                            func(Internal::Resolver<Args>::Get(world, state)...);
+                            state.ticks.lastRun = state.ticks.thisRun;
                         };
 
-            RegisterToScheduler(task);
+            RegisterToScheduler(task, std::move(access));
         }
 
     private:
@@ -130,7 +184,7 @@ namespace FECS::Builder
 
     private:
         template <typename Func>
-        auto RegisterToScheduler(Func&& func) -> void;
+        auto RegisterToScheduler(Func&& func, Internal::SystemAccess access) -> void;
 
         World& m_World;
         float m_Interval = 0.0f;
@@ -0,0 +1,566 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "FECS/Core/ComponentIndex.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Type-erased description of a component stored in archetype tables.
+     */
+    struct ColumnType
+    {
+        std::uint32_t component = NPOS;
+        std::size_t size = 0;
+        std::size_t alignment = 0;
+        void (*moveConstruct)(void* dst, void* src) = nullptr;
+        void (*destroy)(void* ptr) = nullptr;
+        void (*copyConstruct)(void* dst, const void* src) = nullptr; ///< nullptr for move-only components
+
+        template <typename T>
+        static auto Of(std::uint32_t component) -> ColumnType
+        {
+            ColumnType type{
+                component,
+                sizeof(T),
+                alignof(T),
+                [](void* dst, void* src)
+                {
+                    new (dst) T(std::move(*static_cast<T*>(src)));
+                },
+                [](void* ptr)
+                {
+                    static_cast<T*>(ptr)->~T();
+                }};
+
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                type.copyConstruct = [](void* dst, const void* src)
+                {
+                    new (dst) T(*static_cast<const T*>(src));
+                };
+            }
+            return type;
+        }
+    };
+
+    /**
+     * @brief Rows of entities sharing the exact same set of table components.
+     *
+     * Rows are stored in fixed size chunks of TABLE_CHUNK_SIZE bytes, each chunk
+     * holding the entity ids followed by one contiguous array per column. Rows
+     * stay packed, removing a row moves the last one into its place.
+     */
+    class ArchetypeTable
+    {
+    public:
+        explicit ArchetypeTable(std::vector<ColumnType> columns)
+            : m_Columns(std::move(columns))
+        {
+            std::sort(m_Columns.begin(), m_Columns.end(), [](const ColumnType& a, const ColumnType& b)
+            {
+                return a.component < b.component;
+            });
+
+            std::size_t rowBytes = sizeof(Entity);
+            std::size_t padding = 0;
+            m_ChunkAlignment = std::max<std::size_t>(alignof(Entity), 64);
+            for (const ColumnType& column : m_Columns)
+            {
+                m_Signature.push_back(column.component);
+                rowBytes += column.size;
+                padding += column.alignment;
+                m_ChunkAlignment = std::max(m_ChunkAlignment, column.alignment);
+            }
+
+            m_RowsPerChunk = static_cast<std::uint32_t>(std::max<std::size_t>(1, (TABLE_CHUNK_SIZE - std::min(padding, TABLE_CHUNK_SIZE)) / rowBytes));
+
+            std::size_t offset = sizeof(Entity) * m_RowsPerChunk;
+            for (const ColumnType& column : m_Columns)
+            {
+                offset = (offset + column.alignment - 1) / column.alignment * column.alignment;
+                m_Offsets.push_back(offset);
+                offset += column.size * m_RowsPerChunk;
+            }
+            m_ChunkBytes = offset;
+        }
+
+        ~ArchetypeTable()
+        {
+            for (std::uint32_t row = 0; row < m_Size; ++row)
+            {
+                for (std::uint32_t c = 0; c < m_Columns.size(); ++c)
+                {
+                    m_Columns[c].destroy(At(row, c));
+                }
+            }
+
+            for (std::byte* chunk : m_Chunks)
+            {
+                ::operator delete(chunk, std::align_val_t(m_ChunkAlignment));
+            }
+        }
+
+        ArchetypeTable(const ArchetypeTable&) = delete;
+        ArchetypeTable& operator=(const ArchetypeTable&) = delete;
+
+        /// @brief Sorted component indices of the table.
+        auto Signature() const -> const std::vector<std::uint32_t>&
+        {
+            return m_Signature;
+        }
+
+        /// @brief Column holding the component, NPOS if the table doesn't have it.
+        auto ColumnOf(std::uint32_t component) const -> std::uint32_t
+        {
+            auto it = std::lower_bound(m_Signature.begin(), m_Signature.end(), component);
+            if (it == m_Signature.end() || *it != component)
+            {
+                return NPOS;
+            }
+            return static_cast<std::uint32_t>(it - m_Signature.begin());
+        }
+
+        auto Has(std::uint32_t component) const -> bool
+        {
+            return std::binary_search(m_Signature.begin(), m_Signature.end(), component);
+        }
+
+        auto Size() const -> std::size_t
+        {
+            return m_Size;
+        }
+
+        auto RowsPerChunk() const -> std::uint32_t
+        {
+            return m_RowsPerChunk;
+        }
+
+        /// @brief Number of chunks holding at least one row.
+        auto ChunkCount() const -> std::size_t
+        {
+            return (m_Size + m_RowsPerChunk - 1) / m_RowsPerChunk;
+        }
+
+        /// @brief Number of rows stored in the given chunk.
+        auto ChunkSize(std::size_t chunk) const -> std::uint32_t
+        {
+            std::size_t begin = chunk * m_RowsPerChunk;
+            return static_cast<std::uint32_t>(std::min<std::size_t>(m_RowsPerChunk, m_Size - begin));
+        }
+
+        auto Entities(std::size_t chunk) -> Entity*
+        {
+            return reinterpret_cast<Entity*>(m_Chunks[chunk]);
+        }
+
+        /// @brief Start of a column's contiguous array inside a chunk.
+        auto ColumnData(std::size_t chunk, std::uint32_t column) -> void*
+        {
+            return m_Chunks[chunk] + m_Offsets[column];
+        }
+
+        auto At(std::uint32_t row, std::uint32_t column) -> void*
+        {
+            return m_Chunks[row / m_RowsPerChunk] + m_Offsets[column] + (row % m_RowsPerChunk) * m_Columns[column].size;
+        }
+
+        auto EntityAt(std::uint32_t row) -> Entity
+        {
+            return Entities(row / m_RowsPerChunk)[row % m_RowsPerChunk];
+        }
+
+        auto GetColumnType(std::uint32_t column) const -> const ColumnType&
+        {
+            return m_Columns[column];
+        }
+
+        /**
+         * @brief Appends a row for e, the caller must construct every column of it.
+         */
+        auto AddRow(Entity e) -> std::uint32_t
+        {
+            if (m_Size == m_Chunks.size() * m_RowsPerChunk)
+            {
+                m_Chunks.push_back(static_cast<std::byte*>(::operator new(m_ChunkBytes, std::align_val_t(m_ChunkAlignment))));
+            }
+
+            std::uint32_t row = m_Size++;
+            Entities(row / m_RowsPerChunk)[row % m_RowsPerChunk] = e;
+            return row;
+        }
+
+        /**
+         * @brief Destroys a row and fills the hole with the last row.
+         * @return The entity now stored at row, INVALID_ENTITY if the last row was removed.
+         */
+        auto RemoveRow(std::uint32_t row) -> Entity
+        {
+            std::uint32_t last = m_Size - 1;
+            Entity moved = INVALID_ENTITY;
+
+            for (std::uint32_t c = 0; c < m_Columns.size(); ++c)
+            {
+                m_Columns[c].destroy(At(row, c));
+                if (row != last)
+                {
+                    m_Columns[c].moveConstruct(At(row, c), At(last, c));
+                    m_Columns[c].destroy(At(last, c));
+                }
+            }
+
+            if (row != last)
+            {
+                moved = EntityAt(last);
+                Entities(row / m_RowsPerChunk)[row % m_RowsPerChunk] = moved;
+            }
+
+            m_Size--;
+            return moved;
+        }
+
+    private:
+        friend class ArchetypeStorage;
+
+        std::vector<ColumnType> m_Columns;
+        std::vector<std::uint32_t> m_Signature;
+        std::vector<std::size_t> m_Offsets;
+        std::vector<std::byte*> m_Chunks;
+        std::size_t m_ChunkBytes = 0;
+        std::size_t m_ChunkAlignment = 0;
+        std::uint32_t m_RowsPerChunk = 0;
+        std::uint32_t m_Size = 0;
+
+        std::unordered_map<std::uint32_t, ArchetypeTable*> m_AddEdges;    ///< Table reached by attaching a component
+        std::unordered_map<std::uint32_t, ArchetypeTable*> m_RemoveEdges; ///< Table reached by detaching a component
+    };
+
+    /**
+     * @brief Stores every table component of the world, grouping entities by their set of table components.
+     *
+     * Attaching or detaching a table component moves the entity's row to the
+     * table of its new signature. Transitions are cached on the tables so the
+     * lookup only happens once per pair of signatures.
+     */
+    class ArchetypeStorage
+    {
+    public:
+        struct Location
+        {
+            ArchetypeTable* table = nullptr;
+            std::uint32_t row = NPOS;
+        };
+
+        ArchetypeStorage() = default;
+        ArchetypeStorage(const ArchetypeStorage&) = delete;
+        ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+        /**
+         * @brief Constructs T for e, overwriting it if the entity already has one.
+         */
+        template <typename T, typename... Args>
+        auto Emplace(Entity e, Args&&... args) -> T&
+        {
+            std::uint32_t component = Register<T>();
+            Location& location = LocationOf(e);
+
+            if (location.table)
+            {
+                std::uint32_t column = location.table->ColumnOf(component);
+                if (column != NPOS)
+                {
+                    T& existing = *static_cast<T*>(location.table->At(location.row, column));
+                    existing = T(std::forward<Args>(args)...);
+                    return existing;
+                }
+            }
+
+            ArchetypeTable* target = Transition(location.table, component, true);
+            std::uint32_t row = MoveTo(e, target);
+            return *new (target->At(row, target->ColumnOf(component))) T(std::forward<Args>(args)...);
+        }
+
+        /// @brief Detaches T from e, does nothing if it doesn't have it.
+        template <typename T>
+        auto Remove(Entity e) -> void
+        {
+            std::uint32_t component = ::ComponentIndex::GetIndex<T>();
+            std::uint32_t idx = GetEntityIndex(e);
+            if (idx >= m_Locations.size() || !m_Locations[idx].table || !m_Locations[idx].table->Has(component))
+            {
+                return;
+            }
+
+            MoveTo(e, Transition(m_Locations[idx].table, component, false));
+        }
+
+        /// @brief Drops every table component of e.
+        auto RemoveEntity(Entity e) -> void
+        {
+            std::uint32_t idx = GetEntityIndex(e);
+            if (idx < m_Locations.size() && m_Locations[idx].table)
+            {
+                MoveTo(e, nullptr);
+            }
+        }
+
+        /**
+         * @brief Appends rows for entities without table components to the table of components.
+         *
+         * The rows are contiguous, starting at the returned location. The caller
+         * constructs every column of them.
+         * @param components Indices of registered table components, see Register().
+         */
+        auto Append(std::span<const Entity> entities, std::vector<std::uint32_t> components) -> Location
+        {
+            assert(!IsLocked() && "Structural change to a table while it is being iterated in parallel");
+            m_Version++;
+
+            std::sort(components.begin(), components.end());
+            ArchetypeTable* table = FindOrCreate(components);
+            Location first{table, static_cast<std::uint32_t>(table->Size())};
+            for (Entity e : entities)
+            {
+                Location& location = LocationOf(e);
+                assert(!location.table && "Appending an entity that already has table components");
+                location = Location{table, table->AddRow(e)};
+            }
+            return first;
+        }
+
+        /**
+         * @brief Copies the table components of source to every target, which must have none.
+         */
+        auto Instantiate(Entity source, std::span<const Entity> targets) -> void
+        {
+            std::uint32_t idx = GetEntityIndex(source);
+            if (idx >= m_Locations.size() || !m_Locations[idx].table)
+            {
+                return;
+            }
+
+            assert(!IsLocked() && "Structural change to a table while it is being iterated in parallel");
+            m_Version++;
+
+            // Copied, growing m_Locations below invalidates references into it
+            Location prototype = m_Locations[idx];
+            ArchetypeTable* table = prototype.table;
+            for (Entity e : targets)
+            {
+                std::uint32_t row = table->AddRow(e);
+                for (std::uint32_t c = 0; c < table->m_Columns.size(); ++c)
+                {
+                    assert(table->m_Columns[c].copyConstruct && "Instantiating an entity requires copyable components");
+                    table->m_Columns[c].copyConstruct(table->At(row, c), table->At(prototype.row, c));
+                }
+
+                Location& location = LocationOf(e);
+                assert(!location.table && "Instantiating into an entity that already has table components");
+                location = Location{table, row};
+            }
+        }
+
+        /// @brief Makes T known to the storage, returns its component index.
+        template <typename T>
+        auto Register() -> std::uint32_t
+        {
+            static_assert(!ComponentTraits<T>::trackChanges, "Change detection is only supported for pooled components");
+
+            std::uint32_t component = ::ComponentIndex::GetIndex<T>();
+            if (component >= m_Types.size())
+            {
+                m_Types.resize(component + 1);
+            }
+
+            if (m_Types[component].component == NPOS)
+            {
+                m_Types[component] = ColumnType::Of<T>(component);
+            }
+
+            return component;
+        }
+
+        template <typename T>
+        auto Has(Entity e) const -> bool
+        {
+            std::uint32_t idx = GetEntityIndex(e);
+            return idx < m_Locations.size() && m_Locations[idx].table && m_Locations[idx].table->Has(::ComponentIndex::GetIndex<T>());
+        }
+
+        template <typename T>
+        auto Get(Entity e) -> T&
+        {
+            assert(Has<T>(e) && "Failed to retrive component, it doesn't exist on entity");
+            const Location& location = m_Locations[GetEntityIndex(e)];
+            return *static_cast<T*>(location.table->At(location.row, location.table->ColumnOf(::ComponentIndex::GetIndex<T>())));
+        }
+
+        auto GetTables() -> const std::vector<std::unique_ptr<ArchetypeTable>>&
+        {
+            return m_Tables;
+        }
+
+        auto Reserve(std::size_t entities) -> void
+        {
+            m_Locations.reserve(entities);
+        }
+
+        auto Clear() -> void
+        {
+            assert(!IsLocked() && "Structural change to a table while it is being iterated in parallel");
+            m_Version++;
+            m_TableLookup.clear();
+            m_Tables.clear();
+            m_Locations.clear();
+        }
+
+        /// @brief Bumped whenever a row is added, moved or removed in any table.
+        auto GetVersion() const -> std::uint32_t
+        {
+            return m_Version;
+        }
+
+        /// @brief Forbids structural changes until unlocked, see SparseSet::Lock().
+        auto Lock() -> void
+        {
+            m_Locks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto Unlock() -> void
+        {
+            [[maybe_unused]] std::uint32_t locks = m_Locks.fetch_sub(1, std::memory_order_relaxed);
+            assert(locks > 0 && "Unlocking a storage that isn't locked");
+        }
+
+        auto IsLocked() const -> bool
+        {
+            return m_Locks.load(std::memory_order_relaxed) > 0;
+        }
+
+    private:
+        auto LocationOf(Entity e) -> Location&
+        {
+            std::uint32_t idx = GetEntityIndex(e);
+            if (idx >= m_Locations.size())
+            {
+                m_Locations.resize(idx + 1);
+            }
+            return m_Locations[idx];
+        }
+
+        /// @brief Table of the signature of from with component added or removed, nullptr for the empty signature.
+        auto Transition(ArchetypeTable* from, std::uint32_t component, bool add) -> ArchetypeTable*
+        {
+            if (from)
+            {
+                auto& edges = add ? from->m_AddEdges : from->m_RemoveEdges;
+                auto it = edges.find(component);
+                if (it != edges.end())
+                {
+                    return it->second;
+                }
+            }
+
+            std::vector<std::uint32_t> signature = from ? from->Signature() : std::vector<std::uint32_t>();
+            if (add)
+            {
+                signature.insert(std::lower_bound(signature.begin(), signature.end(), component), component);
+            }
+            else
+            {
+                signature.erase(std::lower_bound(signature.begin(), signature.end(), component));
+            }
+
+            ArchetypeTable* to = signature.empty() ? nullptr : FindOrCreate(signature);
+            if (from)
+            {
+                (add ? from->m_AddEdges : from->m_RemoveEdges)[component] = to;
+            }
+            return to;
+        }
+
+        auto FindOrCreate(const std::vector<std::uint32_t>& signature) -> ArchetypeTable*
+        {
+            auto it = m_TableLookup.find(signature);
+            if (it != m_TableLookup.end())
+            {
+                return it->second;
+            }
+
+            std::vector<ColumnType> columns;
+            columns.reserve(signature.size());
+            for (std::uint32_t component : signature)
+            {
+                columns.push_back(m_Types[component]);
+            }
+
+            m_Tables.push_back(std::make_unique<ArchetypeTable>(std::move(columns)));
+            m_TableLookup.emplace(signature, m_Tables.back().get());
+            return m_Tables.back().get();
+        }
+
+        /**
+         * @brief Moves e's row to target, carrying over the shared columns.
+         *
+         * Columns only present in target are left for the caller to construct.
+         * @return The new row, NPOS when target is nullptr.
+         */
+        auto MoveTo(Entity e, ArchetypeTable* target) -> std::uint32_t
+        {
+            assert(!IsLocked() && "Structural change to a table while it is being iterated in parallel");
+            m_Version++;
+
+            Location& location = LocationOf(e);
+            ArchetypeTable* source = location.table;
+
+            std::uint32_t row = NPOS;
+            if (target)
+            {
+                row = target->AddRow(e);
+                if (source)
+                {
+                    for (std::uint32_t c = 0; c < target->m_Columns.size(); ++c)
+                    {
+                        std::uint32_t from = source->ColumnOf(target->m_Signature[c]);
+                        if (from != NPOS)
+                        {
+                            target->m_Columns[c].moveConstruct(target->At(row, c), source->At(location.row, from));
+                        }
+                    }
+                }
+            }
+
+            if (source)
+            {
+                Entity moved = source->RemoveRow(location.row);
+                if (moved != INVALID_ENTITY)
+                {
+                    m_Locations[GetEntityIndex(moved)].row = location.row;
+                }
+            }
+
+            location = Location{target, row};
+            return row;
+        }
+
+        std::vector<std::unique_ptr<ArchetypeTable>> m_Tables;
+        std::map<std::vector<std::uint32_t>, ArchetypeTable*> m_TableLookup;
+        std::vector<ColumnType> m_Types; ///< Indexed by component index, filled on first attach
+        std::vector<Location> m_Locations; ///< Indexed by entity index
+        std::uint32_t m_Version = 0;
+        std::atomic<std::uint32_t> m_Locks = 0; ///< Atomic, systems reading the same data lock it from several threads
+    };
+}
@@ -0,0 +1,259 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "FECS/Containers/ComponentStorage.h"
+#include "FECS/Containers/EntityStorage.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Handle to an entity whose creation was recorded but not yet played back.
+     *
+     * Only valid with the CommandBuffer that returned it.
+     */
+    struct PendingEntity
+    {
+        std::uint32_t index;
+    };
+
+    /**
+     * @brief Records structural changes to apply later, at a point where no pool is being iterated.
+     *
+     * Commands are grouped per component type as they are recorded. Playback
+     * creates the pending entities first, then applies each pool's commands in
+     * one batch sorted by entity index, and destroys entities last. Commands
+     * targeting entities that are dead by then are dropped.
+     */
+    class CommandBuffer
+    {
+    private:
+        /// @brief Target of a component command, either a live entity or a pending one.
+        struct Target
+        {
+            Entity entity;
+            std::uint32_t pending;
+        };
+
+        class ICommandQueue
+        {
+        public:
+            virtual ~ICommandQueue() = default;
+            virtual auto Apply(ComponentStorage& components, const EntityStorage& entities, const std::vector<Entity>& created) -> void = 0;
+
+            bool queued = false; ///< Whether the queue is listed in m_Active
+        };
+
+        template <typename T>
+        class CommandQueue : public ICommandQueue
+        {
+        public:
+            struct Op
+            {
+                Target target;
+                std::uint32_t value; ///< Index into m_Values, NPOS for a detach
+            };
+
+            template <typename... Args>
+            auto Insert(Target target, Args&&... args) -> void
+            {
+                m_Ops.push_back({target, static_cast<std::uint32_t>(m_Values.size())});
+                m_Values.emplace_back(std::forward<Args>(args)...);
+            }
+
+            auto Remove(Target target) -> void
+            {
+                m_Ops.push_back({target, NPOS});
+            }
+
+            auto Apply(ComponentStorage& components, const EntityStorage& entities, const std::vector<Entity>& created) -> void override
+            {
+                std::size_t inserts = 0;
+                for (Op& op : m_Ops)
+                {
+                    if (op.target.pending != NPOS)
+                    {
+                        op.target.entity = created[op.target.pending];
+                        op.target.pending = NPOS;
+                    }
+                    inserts += op.value != NPOS;
+                }
+
+                // Walk the sparse pages in order, stable so commands on one entity keep their recorded order
+                std::stable_sort(m_Ops.begin(), m_Ops.end(), [](const Op& a, const Op& b)
+                {
+                    return GetEntityIndex(a.target.entity) < GetEntityIndex(b.target.entity);
+                });
+
+                if constexpr (IS_TABLE_COMPONENT<T>)
+                {
+                    ArchetypeStorage& tables = components.GetArchetypes();
+                    for (const Op& op : m_Ops)
+                    {
+                        if (!entities.IsAlive(op.target.entity))
+                        {
+                            continue;
+                        }
+
+                        if (op.value == NPOS)
+                        {
+                            tables.Remove<T>(op.target.entity);
+                        }
+                        else
+                        {
+                            tables.Emplace<T>(op.target.entity, std::move(m_Values[op.value]));
+                        }
+                    }
+                }
+                else
+                {
+                    SparseSet<T>* pool = components.GetPool<T>();
+                    pool->ReserveAdditional(inserts);
+                    for (const Op& op : m_Ops)
+                    {
+                        if (!entities.IsAlive(op.target.entity))
+                        {
+                            continue;
+                        }
+
+                        if (op.value == NPOS)
+                        {
+                            pool->Remove(op.target.entity);
+                        }
+                        else
+                        {
+                            pool->Insert(op.target.entity, std::move(m_Values[op.value]));
+                        }
+                    }
+                }
+
+                m_Ops.clear();
+                m_Values.clear();
+                queued = false;
+            }
+
+        private:
+            std::vector<Op> m_Ops;
+            std::vector<T> m_Values;
+        };
+
+    public:
+        CommandBuffer() = default;
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        auto Create() -> PendingEntity
+        {
+            return PendingEntity{m_PendingCount++};
+        }
+
+        auto Destroy(Entity entity) -> void
+        {
+            m_Destroyed.push_back(entity);
+        }
+
+        template <typename T>
+        auto Attach(Entity entity, T&& component) -> void
+        {
+            using Component = std::remove_cvref_t<T>;
+            Queue<Component>().Insert({entity, NPOS}, std::forward<T>(component));
+        }
+
+        template <typename T>
+        auto Attach(PendingEntity entity, T&& component) -> void
+        {
+            using Component = std::remove_cvref_t<T>;
+            Queue<Component>().Insert({INVALID_ENTITY, entity.index}, std::forward<T>(component));
+        }
+
+        template <typename T, typename... Args>
+        auto Emplace(Entity entity, Args&&... args) -> void
+        {
+            Queue<T>().Insert({entity, NPOS}, std::forward<Args>(args)...);
+        }
+
+        template <typename T, typename... Args>
+        auto Emplace(PendingEntity entity, Args&&... args) -> void
+        {
+            Queue<T>().Insert({INVALID_ENTITY, entity.index}, std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        auto Detach(Entity entity) -> void
+        {
+            Queue<T>().Remove({entity, NPOS});
+        }
+
+        auto Empty() const -> bool
+        {
+            return m_PendingCount == 0 && m_Destroyed.empty() && m_Active.empty();
+        }
+
+        /**
+         * @brief Applies every recorded command to the given storages and resets the buffer.
+         */
+        auto Playback(EntityStorage& entities, ComponentStorage& components) -> void
+        {
+            if (Empty())
+            {
+                return;
+            }
+
+            m_Created.clear();
+            m_Created.reserve(m_PendingCount);
+            for (std::uint32_t i = 0; i < m_PendingCount; ++i)
+            {
+                m_Created.push_back(entities.Create());
+            }
+
+            for (std::uint32_t idx : m_Active)
+            {
+                m_Queues[idx]->Apply(components, entities, m_Created);
+            }
+
+            m_Killed.clear();
+            entities.DestroyBatch(m_Destroyed, m_Killed);
+            components.DeleteEntities(m_Killed);
+
+            m_PendingCount = 0;
+            m_Destroyed.clear();
+            m_Active.clear();
+        }
+
+    private:
+        template <typename T>
+        auto Queue() -> CommandQueue<T>&
+        {
+            std::uint32_t idx = ::ComponentIndex::GetIndex<T>();
+            if (idx >= m_Queues.size())
+            {
+                m_Queues.resize(idx + 1);
+            }
+
+            if (!m_Queues[idx])
+            {
+                m_Queues[idx] = std::make_unique<CommandQueue<T>>();
+            }
+
+            if (!m_Queues[idx]->queued)
+            {
+                m_Queues[idx]->queued = true;
+                m_Active.push_back(idx);
+            }
+
+            return static_cast<CommandQueue<T>&>(*m_Queues[idx]);
+        }
+
+        std::uint32_t m_PendingCount = 0;
+        std::vector<Entity> m_Created;
+        std::vector<Entity> m_Destroyed;
+        std::vector<Entity> m_Killed; ///< Alive subset of m_Destroyed, filled during Playback
+        std::vector<std::unique_ptr<ICommandQueue>> m_Queues;
+        std::vector<std::uint32_t> m_Active; ///< Queues holding commands, in first-use order
+    };
+}
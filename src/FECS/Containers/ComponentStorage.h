@@ -1,24 +1,21 @@
 #pragma once
+#include <atomic>
+#include <bit>
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
 #include <vector>
+#include "FECS/Core/ComponentIndex.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/TypeId.h"
 #include "FECS/Core/Types.h"
+#include "FECS/Containers/ArchetypeStorage.h"
+#include "FECS/Containers/EntitySignatures.h"
 #include "FECS/Containers/ISparseSet.h"
+#include "FECS/Containers/OwningGroup.h"
 #include "FECS/Containers/SparseSet.h"
 
-class ComponentIndex
-{
-public:
-    template <typename T>
-    static auto GetIndex() -> std::uint32_t
-    {
-        static const std::uint32_t idx = m_Index++;
-        return idx;
-    }
-
-private:
-    static inline std::uint32_t m_Index = 0;
-};
-
 namespace FECS::Container
 {
     class ComponentStorage
@@ -27,6 +24,9 @@ namespace FECS::Container
         ComponentStorage() = default;
         ~ComponentStorage()
         {
+            // groups detach themselves from their pools, release them first
+            m_Groups.clear();
+
             // clear all heap allocated memory
             for (auto* components : m_Components)
             {
@@ -40,6 +40,8 @@ namespace FECS::Container
         template <typename T>
         auto GetPool() -> Container::SparseSet<T>*
         {
+            static_assert(!IS_TABLE_COMPONENT<T>, "Table components have no pool, they live in GetArchetypes()");
+
             std::uint32_t idx = ::ComponentIndex::GetIndex<T>();
             if (idx >= m_Components.size())
             {
@@ -48,22 +50,98 @@ namespace FECS::Container
 
             if (!m_Components[idx])
             {
-                m_Components[idx] = new Container::SparseSet<T>();
+                auto* pool = new Container::SparseSet<T>();
+                pool->SetTickSource(&m_Tick);
+                pool->SetSignatures(&m_Signatures, idx);
+                m_Signatures.Register(idx);
+                m_Components[idx] = pool;
             }
 
             return static_cast<Container::SparseSet<T>*>(m_Components[idx]);
         }
 
+        /**
+         * @brief The pool of the component with the given TypeId, nullptr if it has none yet.
+         *
+         * Lets snapshots and replication address pools by an id that is the
+         * same in every process, see FECS::TYPE_ID.
+         */
+        auto GetPoolById(TypeId id) -> Container::ISparseSet*
+        {
+            std::uint32_t idx = ::ComponentIndex::Find(id);
+            return idx < m_Components.size() ? m_Components[idx] : nullptr;
+        }
+
+        auto GetArchetypes() -> Container::ArchetypeStorage&
+        {
+            return m_Archetypes;
+        }
+
+        /**
+         * @brief Creates the storage of T ahead of time so later lookups never grow the registry.
+         */
         template <typename T>
-        auto GetVersion() -> std::uint32_t&
+        auto Prepare() -> void
         {
-            std::uint32_t idx = ::ComponentIndex::GetIndex<T>();
-            if (idx >= m_Versions.size())
+            if constexpr (!IS_TABLE_COMPONENT<T>)
             {
-                m_Versions.resize(idx + 1, 0);
+                GetPool<T>();
             }
+        }
 
-            return m_Versions[idx];
+        /**
+         * @brief Returns the group owning the pools of Owned, creating it on first use.
+         *
+         * Creating a group reorders the owned pools, so it must not happen while
+         * they are being iterated. Each pool can belong to a single group. The
+         * order of Owned doesn't matter, every order yields the same group.
+         */
+        template <typename... Owned>
+        auto GetGroup() -> Container::GroupOf<Owned...>*
+        {
+            return FindGroup(static_cast<Container::GroupOf<Owned...>*>(nullptr));
+        }
+
+        /**
+         * @brief Structural version of the pool of T, see ISparseSet::GetVersion().
+         *
+         * GetVersion<GlobalComponent>() is the version of the whole registry,
+         * bumped by ClearRegistry().
+         */
+        template <typename T>
+        auto GetVersion() -> std::uint32_t
+        {
+            if constexpr (std::is_same_v<T, GlobalComponent>)
+            {
+                return m_GlobalVersion;
+            }
+            else if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return m_Archetypes.GetVersion();
+            }
+            else
+            {
+                return GetPool<T>()->GetVersion();
+            }
+        }
+
+        /**
+         * @brief Tick attached and overwritten components are currently stamped with.
+         */
+        auto CurrentTick() const -> Tick
+        {
+            return m_Tick.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Hands out a tick for a system run and moves the counter past it.
+         *
+         * Changes made from then on, whether by the system itself or by the
+         * command buffers flushed after it, compare newer than the returned tick.
+         */
+        auto AdvanceTick() -> Tick
+        {
+            return m_Tick.fetch_add(1, std::memory_order_relaxed);
         }
 
         auto Reserve(std::size_t numComponents) -> void
@@ -71,11 +149,101 @@ namespace FECS::Container
             m_Components.reserve(numComponents);
         }
 
+        /**
+         * @brief Removes every component of the entity, visiting only the pools it owns.
+         */
         auto DeleteEntity(Entity e) -> void
         {
-            for (auto& comps : m_Components)
+            m_Signatures.ForEach(e, [this, e](std::uint32_t component)
             {
-                comps->Remove(e);
+                m_Components[component]->Remove(e);
+            });
+
+            m_Archetypes.RemoveEntity(e);
+        }
+
+        /**
+         * @brief Removes every component of several entities, batching the removals per pool.
+         *
+         * The union of the entities' signatures names the pools to visit, each
+         * of them then drops the whole batch at once, see SparseSet::RemoveBatch().
+         */
+        auto DeleteEntities(std::span<const Entity> entities) -> void
+        {
+            Container::EntitySignatures::Mask owned;
+            for (Entity e : entities)
+            {
+                m_Signatures.Accumulate(e, owned);
+                m_Archetypes.RemoveEntity(e);
+            }
+
+            for (std::size_t w = 0; w < owned.size(); ++w)
+            {
+                for (std::uint64_t word = owned[w]; word; word &= word - 1)
+                {
+                    std::size_t component = w * Container::EntitySignatures::WORD_BITS + std::countr_zero(word);
+                    m_Components[component]->RemoveBatch(entities);
+                }
+            }
+        }
+
+        /**
+         * @brief Copies every component of source to each target, pool by pool.
+         * @param targets Entities without components, typically fresh ones.
+         */
+        auto Instantiate(Entity source, std::span<const Entity> targets) -> void
+        {
+            m_Signatures.ForEach(source, [this, source, targets](std::uint32_t component)
+            {
+                m_Components[component]->CloneBatch(source, targets);
+            });
+
+            m_Archetypes.Instantiate(source, targets);
+        }
+
+        /**
+         * @brief Pooled components of every entity, see Container::EntitySignatures.
+         */
+        auto GetSignatures() const -> const Container::EntitySignatures&
+        {
+            return m_Signatures;
+        }
+
+        auto GetSignatures() -> Container::EntitySignatures&
+        {
+            return m_Signatures;
+        }
+
+        /**
+         * @brief Mask of the pooled components among Ts, table components are left out.
+         *
+         * Built once per type list, the pools are created so the mask stays valid.
+         */
+        template <typename... Ts>
+        auto MaskOf() -> const Container::EntitySignatures::Mask&
+        {
+            (Prepare<Ts>(), ...);
+            static const Container::EntitySignatures::Mask mask = []
+            {
+                Container::EntitySignatures::Mask bits;
+                ((IS_TABLE_COMPONENT<Ts> ? void() : Container::EntitySignatures::AddToMask(bits, ::ComponentIndex::GetIndex<Ts>())), ...);
+                return bits;
+            }();
+            return mask;
+        }
+
+        /**
+         * @brief Calls func(componentIndex, const PoolMemory&) for every pool.
+         */
+        template <typename Func>
+        auto ReportMemory(Func&& func) const -> void
+        {
+            for (std::uint32_t component = 0; component < m_Components.size(); ++component)
+            {
+                if (m_Components[component])
+                {
+                    func(component, m_Components[component]->GetMemoryUsage());
+                }
             }
         }
 
@@ -83,15 +251,44 @@ namespace FECS::Container
         {
             for (auto& comps : m_Components)
             {
-                comps->Clear();
+                if (comps)
+                {
+                    comps->Clear();
+                }
             }
 
-            m_Components.clear();
-            m_Versions.clear();
+            m_Archetypes.Clear();
+            m_Signatures.Clear();
+
+            // Pools are kept alive, queries may still point at them
+            m_GlobalVersion++;
         }
 
     private:
+        template <typename... Owned>
+        auto FindGroup(Container::OwningGroup<Owned...>*) -> Container::OwningGroup<Owned...>*
+        {
+            static const std::uint32_t idx = s_GroupIndex.fetch_add(1, std::memory_order_relaxed);
+            if (idx >= m_Groups.size())
+            {
+                m_Groups.resize(idx + 1);
+            }
+
+            if (!m_Groups[idx])
+            {
+                m_Groups[idx] = std::make_unique<Container::OwningGroup<Owned...>>(GetPool<Owned>()...);
+            }
+
+            return static_cast<Container::OwningGroup<Owned...>*>(m_Groups[idx].get());
+        }
+
+        static inline std::atomic<std::uint32_t> s_GroupIndex = 0;
+
         std::vector<Container::ISparseSet*> m_Components;
-        std::vector<std::uint32_t> m_Versions;
+        std::vector<std::unique_ptr<Container::IOwningGroup>> m_Groups;
+        Container::ArchetypeStorage m_Archetypes;
+        Container::EntitySignatures m_Signatures;
+        std::uint32_t m_GlobalVersion = 0;
+        std::atomic<Tick> m_Tick{1};
     };
 }
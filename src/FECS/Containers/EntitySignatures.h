@@ -0,0 +1,224 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Flat per-entity bitmask of the pooled components an entity owns.
+     *
+     * Every entity index owns a row of 64-bit words, bit i being set when the
+     * entity has a component of ComponentIndex i. Rows are stored back to back,
+     * the row width grows with the number of registered component types.
+     *
+     * Not synchronized, it is mutated only from exclusive systems or at sync points.
+     */
+    class EntitySignatures
+    {
+    public:
+        /// @brief A set of component indices, laid out like a row.
+        using Mask = std::vector<std::uint64_t>;
+
+        static constexpr std::uint32_t WORD_BITS = 64;
+
+        /**
+         * @brief Makes rows wide enough to hold the bit of component.
+         *
+         * Widening re-lays every row out, it happens once per new component type.
+         */
+        auto Register(std::uint32_t component) -> void
+        {
+            std::size_t stride = component / WORD_BITS + 1;
+            if (stride <= m_Stride)
+            {
+                return;
+            }
+
+            std::vector<std::uint64_t> words(m_Rows * stride, 0);
+            for (std::size_t row = 0; row < m_Rows; ++row)
+            {
+                for (std::size_t w = 0; w < m_Stride; ++w)
+                {
+                    words[row * stride + w] = m_Words[row * m_Stride + w];
+                }
+            }
+
+            m_Words = std::move(words);
+            m_Stride = stride;
+        }
+
+        inline auto Set(Entity e, std::uint32_t component) -> void
+        {
+            assert(!InParallel() && "Structural change while parallel systems run, record it in Commands");
+            std::size_t row = GetEntityIndex(e);
+            if (row >= m_Rows)
+            {
+                // Rows grow geometrically, entity indices are handed out in increasing order
+                m_Rows = std::max(row + 1, m_Rows * 2);
+                m_Words.resize(m_Rows * m_Stride, 0);
+            }
+            m_Words[row * m_Stride + component / WORD_BITS] |= Bit(component);
+        }
+
+        inline auto Reset(Entity e, std::uint32_t component) -> void
+        {
+            assert(!InParallel() && "Structural change while parallel systems run, record it in Commands");
+            std::size_t row = GetEntityIndex(e);
+            if (row < m_Rows)
+            {
+                m_Words[row * m_Stride + component / WORD_BITS] &= ~Bit(component);
+            }
+        }
+
+        inline auto Test(Entity e, std::uint32_t component) const -> bool
+        {
+            std::size_t row = GetEntityIndex(e);
+            std::size_t word = component / WORD_BITS;
+            return row < m_Rows && word < m_Stride && (m_Words[row * m_Stride + word] & Bit(component));
+        }
+
+        /// @brief Whether the entity owns every component of the mask.
+        inline auto HasAll(Entity e, const Mask& mask) const -> bool
+        {
+            const std::uint64_t* row = Row(e);
+            for (std::size_t w = 0; w < mask.size(); ++w)
+            {
+                std::uint64_t owned = row && w < m_Stride ? row[w] : 0;
+                if ((owned & mask[w]) != mask[w])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Whether the entity owns at least one component of the mask.
+        inline auto HasAny(Entity e, const Mask& mask) const -> bool
+        {
+            const std::uint64_t* row = Row(e);
+            if (!row)
+            {
+                return false;
+            }
+
+            for (std::size_t w = 0; w < mask.size() && w < m_Stride; ++w)
+            {
+                if (row[w] & mask[w])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// @brief Adds the components the entity owns to mask.
+        inline auto Accumulate(Entity e, Mask& mask) const -> void
+        {
+            const std::uint64_t* row = Row(e);
+            if (!row)
+            {
+                return;
+            }
+
+            mask.resize(m_Stride, 0);
+            for (std::size_t w = 0; w < m_Stride; ++w)
+            {
+                mask[w] |= row[w];
+            }
+        }
+
+        /**
+         * @brief Calls func(componentIndex) for every component the entity owns.
+         *
+         * Words are read before visiting their bits, so func may reset bits of the entity.
+         */
+        template <typename Func>
+        auto ForEach(Entity e, Func&& func) const -> void
+        {
+            std::size_t row = GetEntityIndex(e);
+            if (row >= m_Rows)
+            {
+                return;
+            }
+
+            for (std::size_t w = 0; w < m_Stride; ++w)
+            {
+                std::uint64_t word = m_Words[row * m_Stride + w];
+                while (word)
+                {
+                    func(static_cast<std::uint32_t>(w * WORD_BITS + std::countr_zero(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+
+        /**
+         * @brief Marks a non-exclusive system of a parallel dispatch as running, see Set().
+         *
+         * Only tracked in debug builds, where Set and Reset assert none is.
+         */
+        auto EnterParallel() -> void
+        {
+#ifndef NDEBUG
+            m_Parallel.fetch_add(1, std::memory_order_relaxed);
+#endif
+        }
+
+        auto LeaveParallel() -> void
+        {
+#ifndef NDEBUG
+            m_Parallel.fetch_sub(1, std::memory_order_relaxed);
+#endif
+        }
+
+        auto Clear() -> void
+        {
+            m_Words.clear();
+            m_Rows = 0;
+        }
+
+        /// @brief Sets the bit of component in mask, growing it as needed.
+        static auto AddToMask(Mask& mask, std::uint32_t component) -> void
+        {
+            if (component / WORD_BITS >= mask.size())
+            {
+                mask.resize(component / WORD_BITS + 1, 0);
+            }
+            mask[component / WORD_BITS] |= Bit(component);
+        }
+
+    private:
+        static constexpr auto Bit(std::uint32_t component) -> std::uint64_t
+        {
+            return std::uint64_t{1} << (component % WORD_BITS);
+        }
+
+        inline auto InParallel() const -> bool
+        {
+#ifndef NDEBUG
+            return m_Parallel.load(std::memory_order_relaxed) != 0;
+#else
+            return false;
+#endif
+        }
+
+        inline auto Row(Entity e) const -> const std::uint64_t*
+        {
+            std::size_t row = GetEntityIndex(e);
+            return row < m_Rows ? &m_Words[row * m_Stride] : nullptr;
+        }
+
+        std::vector<std::uint64_t> m_Words;
+        std::size_t m_Stride = 1;
+        std::size_t m_Rows = 0;
+#ifndef NDEBUG
+        std::atomic<std::uint32_t> m_Parallel = 0; ///< Running non-exclusive systems of a parallel dispatch
+#endif
+    };
+}
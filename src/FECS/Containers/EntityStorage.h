@@ -1,54 +1,322 @@
 #pragma once
 #include "FECS/Core/Types.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <span>
 #include <vector>
 
 namespace FECS::Container
 {
-    class EntityStorage
+    /**
+     * @brief Hands out entity handles, recycling the slots of destroyed ones.
+     *
+     * Every slot holds one handle. Alive slots hold the entity itself, dead
+     * slots form the free list in place: they hold the index of the next free
+     * slot together with the version the slot is reused with.
+     *
+     * Worker threads can reserve entities concurrently with ReserveEntity(),
+     * they become alive at the next FlushReserved(). Every other member
+     * requires exclusive access.
+     *
+     * @tparam Traits Handle encoding, see BasicEntityTraits. Versions wrap
+     * around to 0 after Traits::MAX_VERSION reuses of a slot.
+     */
+    template <typename Traits>
+    class BasicEntityStorage
     {
     public:
-        EntityStorage() = default;
+        using Handle = typename Traits::Type;
 
-        auto Reserve(std::uint32_t amount) -> void
+        /// @brief Index ending the free list, never handed out, see BasicEntityTraits::MAX_INDEX.
+        static constexpr std::uint32_t NO_SLOT = static_cast<std::uint32_t>(Traits::INDEX_MASK);
+
+        /**
+         * @brief A run of consecutive fresh entities, see CreateRange().
+         */
+        class Range
+        {
+        public:
+            class Iterator
+            {
+            public:
+                explicit Iterator(std::uint32_t idx)
+                    : m_Index(idx)
+                {
+                }
+
+                auto operator*() const -> Handle
+                {
+                    return Traits::Build(m_Index, 0);
+                }
+
+                auto operator++() -> Iterator&
+                {
+                    ++m_Index;
+                    return *this;
+                }
+
+                auto operator==(const Iterator& other) const -> bool = default;
+
+            private:
+                std::uint32_t m_Index;
+            };
+
+            Range(std::uint32_t first, std::uint32_t count)
+                : m_First(first),
+                  m_Count(count)
+            {
+            }
+
+            auto operator[](std::size_t i) const -> Handle
+            {
+                assert(i < m_Count && "Position is out of range");
+                return Traits::Build(m_First + static_cast<std::uint32_t>(i), 0);
+            }
+
+            auto FirstIndex() const -> std::uint32_t
+            {
+                return m_First;
+            }
+
+            auto Size() const -> std::size_t
+            {
+                return m_Count;
+            }
+
+            auto begin() const -> Iterator
+            {
+                return Iterator(m_First);
+            }
+
+            auto end() const -> Iterator
+            {
+                return Iterator(m_First + m_Count);
+            }
+
+        private:
+            std::uint32_t m_First;
+            std::uint32_t m_Count;
+        };
+
+        BasicEntityStorage() = default;
+        BasicEntityStorage(const BasicEntityStorage&) = delete;
+        BasicEntityStorage& operator=(const BasicEntityStorage&) = delete;
+
+        auto Reserve(std::size_t amount) -> void
         {
-            m_Versions.reserve(amount);
-            m_FreeList.reserve(amount);
+            m_Slots.reserve(amount);
         }
 
-        auto Create() -> Entity
+        auto Create() -> Handle
         {
-            std::uint32_t idx;
+            SettleReserved();
+            if (m_FreeHead == NO_SLOT)
+            {
+                return *CreateRange(1).begin();
+            }
+
+            // The dead slot links to the next free one and already carries the new version
+            std::uint32_t idx = m_FreeHead;
+            Handle& slot = m_Slots[idx];
+            m_FreeHead = Traits::Index(slot);
+            m_ReservedHead.store(m_FreeHead, std::memory_order_relaxed);
+            m_FreeCount--;
+            slot = Traits::Build(idx, Traits::Version(slot));
+            return slot;
+        }
 
-            // Reuse from freelist if possible
-            if (m_FreeList.empty())
+        /**
+         * @brief Creates count entities in consecutive fresh slots, the free list is left alone.
+         *
+         * The entities all have version 0, the returned range computes them
+         * from their indices instead of storing them.
+         */
+        auto CreateRange(std::size_t count) -> Range
+        {
+            SettleReserved();
+            std::uint32_t first = static_cast<std::uint32_t>(m_Slots.size());
+            assert(m_Slots.size() + count <= std::size_t(Traits::MAX_INDEX) + 1 && "Out of entity indices, see FECS_64BIT_ENTITIES");
+
+            m_Slots.resize(m_Slots.size() + count);
+            for (std::uint32_t idx = first; idx < m_Slots.size(); ++idx)
+            {
+                m_Slots[idx] = Traits::Build(idx, 0);
+            }
+            return Range(first, static_cast<std::uint32_t>(count));
+        }
+
+        /**
+         * @brief Creates count entities, recycling free indices first.
+         * @param created Receives the new entities.
+         */
+        auto CreateMany(std::size_t count, std::vector<Handle>& created) -> void
+        {
+            SettleReserved();
+            created.reserve(created.size() + count);
+
+            std::size_t recycled = std::min(count, m_FreeCount);
+            for (std::size_t i = 0; i < recycled; ++i)
             {
-                idx = static_cast<std::uint32_t>(m_Versions.size());
-                m_Versions.push_back(0); ///< First version is always 0
+                created.push_back(Create());
             }
-            else
+
+            for (Handle e : CreateRange(count - recycled))
             {
-                idx = m_FreeList.back();
-                m_FreeList.pop_back();
+                created.push_back(e);
             }
-            return FECS::BuildEntityIndex(idx, m_Versions[idx]);
         }
 
-        auto Destroy(Entity e) -> void
+        /// @brief Destroys an alive entity, dead ones are skipped.
+        auto Destroy(Handle e) -> void
         {
-            std::uint32_t idx = FECS::GetEntityIndex(e);
-            m_Versions[idx]++;
-            m_FreeList.push_back(idx);
+            SettleReserved();
+            if (IsAlive(e))
+            {
+                Release(Traits::Index(e));
+            }
         }
 
-        auto IsAlive(Entity e) const -> bool
+        /**
+         * @brief Destroys the alive entities among several.
+         * @param destroyed Receives the entities actually destroyed, dead and duplicate ones are skipped.
+         */
+        auto DestroyBatch(std::span<const Handle> entities, std::vector<Handle>& destroyed) -> void
         {
-            std::uint32_t idx = FECS::GetEntityIndex(e);
-            std::uint32_t ver = FECS::GetEntityVersion(e);
-            return (idx < m_Versions.size() && m_Versions[idx] == ver);
+            SettleReserved();
+            for (Handle e : entities)
+            {
+                if (IsAlive(e))
+                {
+                    Release(Traits::Index(e));
+                    destroyed.push_back(e);
+                }
+            }
+        }
+
+        /**
+         * @brief Reserves an entity, safe to call from several threads at once.
+         *
+         * Pops the free list without locking, or bumps past the last slot once
+         * it is empty. The entity isn't alive before the next FlushReserved(),
+         * but its handle is final and can be recorded into a CommandBuffer.
+         * Must not run concurrently with anything but other reservations.
+         */
+        auto ReserveEntity() -> Handle
+        {
+            // Slots only change in FlushReserved(), so the links read here are stable and no head comes back (no ABA)
+            std::uint32_t idx = m_ReservedHead.load(std::memory_order_acquire);
+            while (idx != NO_SLOT)
+            {
+                Handle slot = m_Slots[idx];
+                if (m_ReservedHead.compare_exchange_weak(idx, Traits::Index(slot), std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    return Traits::Build(idx, Traits::Version(slot));
+                }
+            }
+
+            std::size_t fresh = m_Slots.size() + m_ReservedFresh.fetch_add(1, std::memory_order_relaxed);
+            assert(fresh <= Traits::MAX_INDEX && "Out of entity indices, see FECS_64BIT_ENTITIES");
+            return Traits::Build(static_cast<std::uint32_t>(fresh), 0);
+        }
+
+        /// @brief Whether reserved entities are waiting for FlushReserved().
+        auto HasReserved() const -> bool
+        {
+            return m_ReservedHead.load(std::memory_order_relaxed) != m_FreeHead || m_ReservedFresh.load(std::memory_order_relaxed) != 0;
+        }
+
+        /**
+         * @brief Makes every reserved entity alive, called at sync points.
+         *
+         * The recycled ones are the run of the free list ReserveEntity() popped,
+         * from the settled head up to the reservation head. The fresh ones
+         * follow the last slot.
+         */
+        auto FlushReserved() -> void
+        {
+            std::uint32_t end = m_ReservedHead.load(std::memory_order_acquire);
+            while (m_FreeHead != end)
+            {
+                std::uint32_t idx = m_FreeHead;
+                Handle& slot = m_Slots[idx];
+                m_FreeHead = Traits::Index(slot);
+                m_FreeCount--;
+                slot = Traits::Build(idx, Traits::Version(slot));
+            }
+
+            std::size_t fresh = m_ReservedFresh.exchange(0, std::memory_order_relaxed);
+            if (fresh > 0)
+            {
+                std::uint32_t first = static_cast<std::uint32_t>(m_Slots.size());
+                m_Slots.resize(m_Slots.size() + fresh);
+                for (std::uint32_t idx = first; idx < m_Slots.size(); ++idx)
+                {
+                    m_Slots[idx] = Traits::Build(idx, 0);
+                }
+            }
+        }
+
+        /// @brief Reserved entities count as dead until FlushReserved().
+        auto IsAlive(Handle e) const -> bool
+        {
+            std::uint32_t idx = Traits::Index(e);
+            return idx < m_Slots.size() && m_Slots[idx] == e;
+        }
+
+        /// @brief Number of alive entities.
+        auto AliveCount() const -> std::size_t
+        {
+            return m_Slots.size() - m_FreeCount;
+        }
+
+        /**
+         * @brief Calls func(Handle) for every alive entity, in index order.
+         *
+         * func must not create or destroy entities.
+         */
+        template <typename Func>
+        auto EachAlive(Func&& func) const -> void
+        {
+            for (std::uint32_t idx = 0; idx < m_Slots.size(); ++idx)
+            {
+                // A dead slot links to another index, or to NO_SLOT
+                if (Traits::Index(m_Slots[idx]) == idx)
+                {
+                    func(m_Slots[idx]);
+                }
+            }
         }
 
     private:
-        std::vector<std::uint32_t> m_Versions;
-        std::vector<std::uint32_t> m_FreeList;
+        /// @brief Flushes pending reservations first, so the free list is settled before it is touched.
+        inline auto SettleReserved() -> void
+        {
+            if (HasReserved())
+            {
+                FlushReserved();
+            }
+        }
+
+        /// @brief Pushes a slot onto the free list, bumping its version within the version bits.
+        inline auto Release(std::uint32_t idx) -> void
+        {
+            std::uint32_t version = Traits::Version(m_Slots[idx]);
+            version = version == Traits::MAX_VERSION ? 0 : version + 1;
+            m_Slots[idx] = Traits::Build(m_FreeHead, version);
+            m_FreeHead = idx;
+            m_ReservedHead.store(idx, std::memory_order_relaxed);
+            m_FreeCount++;
+        }
+
+        std::vector<Handle> m_Slots;
+        std::uint32_t m_FreeHead = NO_SLOT;
+        std::size_t m_FreeCount = 0;
+
+        std::atomic<std::uint32_t> m_ReservedHead = NO_SLOT; ///< Free list head as seen by ReserveEntity(), ahead of m_FreeHead while reservations are pending
+        std::atomic<std::size_t> m_ReservedFresh = 0;        ///< Fresh indices reserved past the last slot
     };
+
+    /// @brief Entity storage of the build's handle encoding, see FECS::EntityTraits.
+    using EntityStorage = BasicEntityStorage<EntityTraits>;
 }
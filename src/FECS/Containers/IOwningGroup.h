@@ -0,0 +1,32 @@
+#pragma once
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Interface through which an owned pool notifies its group of structural changes.
+     *
+     * Pools only call it for entities entering or leaving the pool, overwriting
+     * an existing component never affects the group.
+     */
+    class IOwningGroup
+    {
+    public:
+        virtual ~IOwningGroup() = default;
+
+        /**
+         * @brief Called after e was inserted into one of the owned pools.
+         */
+        virtual auto OnInsert(Entity e) -> void = 0;
+
+        /**
+         * @brief Called before e is removed from one of the owned pools.
+         */
+        virtual auto OnRemove(Entity e) -> void = 0;
+
+        /**
+         * @brief Called when one of the owned pools was cleared.
+         */
+        virtual auto OnClear() -> void = 0;
+    };
+}
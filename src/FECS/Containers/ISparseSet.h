@@ -1,8 +1,28 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "FECS/Containers/EntitySignatures.h"
 #include "FECS/Core/Types.h"
 
 namespace FECS::Container
 {
+    /// @brief Heap bytes held by a pool, see ISparseSet::GetMemoryUsage().
+    struct PoolMemory
+    {
+        std::size_t dense = 0;    ///< Component values, allocated capacity included
+        std::size_t entities = 0; ///< Dense entity list and change ticks
+        std::size_t sparse = 0;   ///< Sparse index, pooled pages included
+        std::size_t sparsePages = 0;
+        std::size_t presence = 0; ///< Presence bitmap, see ComponentTraits::presenceBitmap
+        bool hashed = false;      ///< Whether the sparse index currently is a hash map
+
+        auto Total() const -> std::size_t
+        {
+            return dense + entities + sparse + presence;
+        }
+    };
+
     /**
      * @brief Interface for type-erased sparse sets.
      *
@@ -20,9 +40,51 @@ namespace FECS::Container
          */
         virtual auto Remove(Entity e) -> void = 0;
 
+        /**
+         * @brief Removes the components of several entities at once.
+         * @param entities Entities to remove, ones without a component are skipped.
+         */
+        virtual auto RemoveBatch(std::span<const Entity> entities) -> void = 0;
+
+        /**
+         * @brief Gives each target a copy of the source entity's component.
+         * @param targets Entities that don't have the component yet.
+         */
+        virtual auto CloneBatch(Entity source, std::span<const Entity> targets) -> void = 0;
+
         /**
          * @brief Clears all components in the pool.
          */
         virtual auto Clear() -> void = 0;
+
+        /**
+         * @brief Heap memory held by the pool, broken down by part.
+         */
+        virtual auto GetMemoryUsage() const -> PoolMemory = 0;
+
+        /**
+         * @brief Structural version of the pool.
+         *
+         * Bumped whenever the set of entities in the pool, or their dense order,
+         * changes. Overwriting an existing component leaves it untouched.
+         */
+        auto GetVersion() const -> std::uint32_t
+        {
+            return m_Version;
+        }
+
+        /**
+         * @brief Mirrors membership into the bit of component in signatures.
+         */
+        auto SetSignatures(EntitySignatures* signatures, std::uint32_t component) -> void
+        {
+            p_Signatures = signatures;
+            m_ComponentIndex = component;
+        }
+
+    protected:
+        std::uint32_t m_Version = 0;
+        EntitySignatures* p_Signatures = nullptr;
+        std::uint32_t m_ComponentIndex = 0;
     };
 }
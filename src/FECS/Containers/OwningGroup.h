@@ -0,0 +1,149 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include "FECS/Containers/IOwningGroup.h"
+#include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/TypeId.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Keeps the entities having every owned component packed at the front of each owned pool.
+     *
+     * For i in [0, Size()), the i-th dense element of every owned pool belongs
+     * to the same entity, so iterating the group is a lockstep walk over the
+     * dense arrays. Inserts swap a newly complete entity to the end of the
+     * prefix, removals swap a leaving entity out of it.
+     */
+    template <typename... Owned>
+    class OwningGroup : public IOwningGroup
+    {
+    public:
+        OwningGroup(SparseSet<Owned>*... pools)
+            : m_Pools(pools...)
+        {
+            static_assert(sizeof...(Owned) > 1, "A group needs at least two owned components");
+            (pools->SetOwningGroup(this), ...);
+
+            // Pack the entities that already have everything
+            for (Entity e : Driver()->GetEntities())
+            {
+                OnInsert(e);
+            }
+        }
+
+        ~OwningGroup()
+        {
+            (std::get<SparseSet<Owned>*>(m_Pools)->SetOwningGroup(nullptr), ...);
+        }
+
+        OwningGroup(const OwningGroup&) = delete;
+        OwningGroup& operator=(const OwningGroup&) = delete;
+
+        auto OnInsert(Entity e) -> void override
+        {
+            if (!(std::get<SparseSet<Owned>*>(m_Pools)->Has(e) && ...) || Contains(e))
+            {
+                return;
+            }
+
+            (SwapInto<Owned>(e, m_Size), ...);
+            m_Size++;
+        }
+
+        auto OnRemove(Entity e) -> void override
+        {
+            if (!Contains(e))
+            {
+                return;
+            }
+
+            m_Size--;
+            (SwapInto<Owned>(e, m_Size), ...);
+        }
+
+        auto OnClear() -> void override
+        {
+            m_Size = 0;
+        }
+
+        /// @brief Number of entities owning every component of the group.
+        auto Size() const -> std::size_t
+        {
+            return m_Size;
+        }
+
+        template <typename T>
+        auto GetPool() -> SparseSet<T>*
+        {
+            return std::get<SparseSet<T>*>(m_Pools);
+        }
+
+        /// @brief The group's entities, valid over [0, Size()).
+        auto GetEntities() -> fast_vector<Entity>&
+        {
+            return Driver()->GetEntities();
+        }
+
+    private:
+        using Pools = std::tuple<SparseSet<Owned>*...>;
+
+        auto Driver() -> SparseSet<std::tuple_element_t<0, std::tuple<Owned...>>>*
+        {
+            return std::get<0>(m_Pools);
+        }
+
+        auto Contains(Entity e) -> bool
+        {
+            return Driver()->DenseIndex(e) < m_Size;
+        }
+
+        template <typename T>
+        auto SwapInto(Entity e, std::uint32_t position) -> void
+        {
+            SparseSet<T>* pool = std::get<SparseSet<T>*>(m_Pools);
+            pool->SwapDense(pool->DenseIndex(e), position);
+        }
+
+        Pools m_Pools;
+        std::uint32_t m_Size = 0;
+    };
+
+    namespace Internal
+    {
+        /// @brief OwningGroup of Owned in TypeId order, so every spelling of the same set is one type.
+        template <typename... Owned>
+        struct CanonicalGroup
+        {
+            static constexpr std::array<std::size_t, sizeof...(Owned)> ORDER = []
+            {
+                std::array<TypeId, sizeof...(Owned)> ids = {TYPE_ID<Owned>...};
+                std::array<std::size_t, sizeof...(Owned)> order = {};
+                for (std::size_t i = 0; i < order.size(); ++i)
+                {
+                    order[i] = i;
+                }
+                std::sort(order.begin(), order.end(), [&ids](std::size_t a, std::size_t b)
+                {
+                    return ids[a] < ids[b];
+                });
+                return order;
+            }();
+
+            template <std::size_t... I>
+            static auto Sorted(std::index_sequence<I...>) -> OwningGroup<std::tuple_element_t<ORDER[I], std::tuple<Owned...>>...>;
+
+            using Type = decltype(Sorted(std::make_index_sequence<sizeof...(Owned)>{}));
+        };
+    }
+
+    /// @brief The group owning the pools of Owned, whatever their order, see ComponentStorage::GetGroup().
+    template <typename... Owned>
+    using GroupOf = typename Internal::CanonicalGroup<Owned...>::Type;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/SoA.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief The pool of T resolved once, for repeated access without the registry lookup.
+     *
+     * ComponentManager::Get<T>() and friends look the pool up on every call.
+     * A handle holds the SparseSet<T> itself, so Get, Has and TryGet inline to
+     * the sparse lookup. A handle to a const T only reads. Handles stay valid
+     * as long as the World does.
+     *
+     * Insert and Remove change structure every pool shares, like the entity
+     * signatures and owning groups. Handles given to systems and queries are
+     * therefore lookup only (STRUCTURAL false), which keeps them safe in
+     * parallel systems. Those record structural changes in Commands instead.
+     */
+    template <typename T, bool STRUCTURAL = true>
+    class PoolHandle
+    {
+        static_assert(!IS_TABLE_COMPONENT<T>, "Table components have no pool, they live in ComponentStorage::GetArchetypes()");
+
+    public:
+        using Component = std::remove_const_t<T>;
+        using Pool = std::conditional_t<std::is_const_v<T>, const SparseSet<Component>, SparseSet<Component>>;
+
+        PoolHandle() = default;
+
+        explicit PoolHandle(Pool* pool)
+            : p_Pool(pool)
+        {
+        }
+
+        /// @brief A read-only handle to the same pool.
+        operator PoolHandle<const Component, STRUCTURAL>() const
+            requires(!std::is_const_v<T>)
+        {
+            return PoolHandle<const Component, STRUCTURAL>(p_Pool);
+        }
+
+        /// @brief A lookup only handle to the same pool.
+        operator PoolHandle<T, false>() const
+            requires(STRUCTURAL)
+        {
+            return PoolHandle<T, false>(p_Pool);
+        }
+
+        inline auto Has(Entity e) const -> bool
+        {
+            return p_Pool->Has(e);
+        }
+
+        /// @brief Reference to the entity's component, which must exist.
+        inline auto Get(Entity e) const -> ComponentRef<T>
+        {
+            return p_Pool->Get(e);
+        }
+
+        /// @brief Pointer to the entity's component, nullptr if it has none.
+        inline auto TryGet(Entity e) const -> T*
+            requires(!IS_SOA_COMPONENT<Component>)
+        {
+            return p_Pool->TryGet(e);
+        }
+
+        inline auto Insert(Entity e, const Component& component) const -> void
+            requires(STRUCTURAL && !std::is_const_v<T>)
+        {
+            p_Pool->Insert(e, component);
+        }
+
+        inline auto Insert(Entity e, Component&& component) const -> void
+            requires(STRUCTURAL && !std::is_const_v<T>)
+        {
+            p_Pool->Insert(e, std::move(component));
+        }
+
+        inline auto Remove(Entity e) const -> void
+            requires(STRUCTURAL && !std::is_const_v<T>)
+        {
+            p_Pool->Remove(e);
+        }
+
+        inline auto Size() const -> std::size_t
+        {
+            return p_Pool->Size();
+        }
+
+        inline auto GetPool() const -> Pool*
+        {
+            return p_Pool;
+        }
+
+        explicit operator bool() const
+        {
+            return p_Pool != nullptr;
+        }
+
+    private:
+        Pool* p_Pool = nullptr;
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "FECS/Containers/fast_vector.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief One bit per entity index, set while the index is part of a pool.
+     *
+     * Answers membership without touching the sparse pages, and lets joins
+     * intersect several pools 64 indices at a time, see GetWord(). Bits are
+     * stored in pages of WORDS_PER_PAGE words, pages without a set bit point
+     * at a shared zero page, so a rare component far out in the index range
+     * only pays for the page table and the pages it touches.
+     */
+    class PresenceBitmap
+    {
+    public:
+        using Word = std::uint64_t;
+
+        static constexpr std::size_t WORD_BITS = 64;
+
+        /// @brief Words per page, 4096 indices.
+        static constexpr std::size_t WORDS_PER_PAGE = 64;
+
+        inline auto Test(std::uint32_t idx) const -> bool
+        {
+            return (GetWord(idx / WORD_BITS) >> (idx % WORD_BITS)) & 1;
+        }
+
+        inline auto Set(std::uint32_t idx) -> void
+        {
+            std::size_t w = idx / WORD_BITS;
+            Word* page = MutablePage(w / WORDS_PER_PAGE);
+            page[w % WORDS_PER_PAGE] |= Word(1) << (idx % WORD_BITS);
+        }
+
+        inline auto Reset(std::uint32_t idx) -> void
+        {
+            std::size_t w = idx / WORD_BITS;
+            std::size_t p = w / WORDS_PER_PAGE;
+            if (p < m_Pages.size() && m_Pages[p] != ZeroPage())
+            {
+                m_Pages[p][w % WORDS_PER_PAGE] &= ~(Word(1) << (idx % WORD_BITS));
+            }
+        }
+
+        /// @brief Makes room in the page table for indices up to highest, pages are still allocated on first Set().
+        inline auto Prepare(std::uint32_t highest) -> void
+        {
+            std::size_t pages = highest / WORD_BITS / WORDS_PER_PAGE + 1;
+            if (pages > m_Pages.size())
+            {
+                Grow(pages);
+            }
+        }
+
+        /// @brief The bits of indices [w * 64, w * 64 + 64), zero past the end.
+        inline auto GetWord(std::size_t w) const -> Word
+        {
+            std::size_t p = w / WORDS_PER_PAGE;
+            return p < m_Pages.size() ? m_Pages[p][w % WORDS_PER_PAGE] : 0;
+        }
+
+        /// @brief Number of words that may hold set bits.
+        inline auto WordCount() const -> std::size_t
+        {
+            return m_Pages.size() * WORDS_PER_PAGE;
+        }
+
+        auto Count() const -> std::size_t
+        {
+            std::size_t count = 0;
+            for (const std::unique_ptr<Word[]>& page : m_Owned)
+            {
+                for (std::size_t w = 0; w < WORDS_PER_PAGE; ++w)
+                {
+                    count += std::popcount(page[w]);
+                }
+            }
+            return count;
+        }
+
+        auto Clear() -> void
+        {
+            m_Pages.clear();
+            m_Owned.clear();
+        }
+
+        auto MemoryUsage() const -> std::size_t
+        {
+            return m_Pages.memory_usage() + m_Owned.capacity() * sizeof(std::unique_ptr<Word[]>) + m_Owned.size() * WORDS_PER_PAGE * sizeof(Word);
+        }
+
+    private:
+        /// @brief All-zero page every absent page points at, never written.
+        static auto ZeroPage() -> Word*
+        {
+            alignas(64) static Word zero[WORDS_PER_PAGE] = {};
+            return zero;
+        }
+
+        inline auto MutablePage(std::size_t p) -> Word*
+        {
+            if (p >= m_Pages.size())
+            {
+                Grow(p + 1);
+            }
+
+            if (m_Pages[p] == ZeroPage())
+            {
+                m_Owned.push_back(std::make_unique<Word[]>(WORDS_PER_PAGE));
+                m_Pages[p] = m_Owned.back().get();
+            }
+            return m_Pages[p];
+        }
+
+        auto Grow(std::size_t pages) -> void
+        {
+            std::size_t old = m_Pages.size();
+            if (pages > m_Pages.capacity())
+            {
+                m_Pages.reserve(std::max(pages, m_Pages.capacity() * 2));
+            }
+            m_Pages.resize(pages);
+            std::fill(m_Pages.begin() + old, m_Pages.end(), ZeroPage());
+        }
+
+        fast_vector<Word*> m_Pages;                 ///< Page table, absent pages point at ZeroPage()
+        std::vector<std::unique_ptr<Word[]>> m_Owned; ///< Pages holding set bits, in allocation order
+    };
+}
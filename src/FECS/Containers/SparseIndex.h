@@ -0,0 +1,514 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FECS/Core/Simd.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Container
+{
+    /**
+     * @brief Maps entity indices to dense positions, picking its representation by density.
+     *
+     * Sparse pools keep an open-addressing hash map, dense ones a table of
+     * fixed-size pages. Missing pages all point at one shared read-only page of
+     * NPOS, and pages whose last entry is unlinked go back to a small page pool.
+     * The index switches to pages once they take no more memory than the hash
+     * map would, and back to hashing when pages drop far below that density.
+     */
+    template <std::size_t PAGE_SIZE>
+    class SparseIndex
+    {
+    public:
+        using Page = std::array<std::uint32_t, PAGE_SIZE>;
+
+        /// @brief Page slots one hash map entry costs, a bucket is two slots and buckets are at most half full.
+        static constexpr std::size_t HASH_ENTRY_SLOTS = 4;
+
+        /// @brief Paged indices fall back to hashing below 1/DEMOTE_RATIO of the density that made them paged.
+        static constexpr std::size_t DEMOTE_RATIO = 4;
+
+        /// @brief Empty pages kept for reuse, the rest is freed.
+        static constexpr std::size_t MAX_POOLED_PAGES = 8;
+
+        static constexpr std::size_t MIN_BUCKETS = 8;
+
+        SparseIndex() = default;
+        SparseIndex(const SparseIndex&) = delete;
+        SparseIndex& operator=(const SparseIndex&) = delete;
+
+        ~SparseIndex()
+        {
+            for (Page* page : m_Pages)
+            {
+                if (page != EmptyPage())
+                {
+                    delete page;
+                }
+            }
+            for (Page* page : m_FreePages)
+            {
+                delete page;
+            }
+        }
+
+        inline auto Find(std::uint32_t idx) const -> std::uint32_t
+        {
+            std::size_t p = idx / PAGE_SIZE;
+            if (p < m_Pages.size())
+            {
+                return (*m_Pages[p])[idx % PAGE_SIZE];
+            }
+
+            return m_Buckets.empty() ? NPOS : FindHashed(idx);
+        }
+
+        /**
+         * @brief Looks up the indices of count entities at once, NPOS for the unmapped ones.
+         *
+         * With AVX2, paged indices of power of two page sizes resolve four
+         * entities per pair of gathers (page pointers, then slots).
+         */
+        inline auto FindBatch(const Entity* entities, std::size_t count, std::uint32_t* slots) const -> void
+        {
+            std::size_t i = 0;
+#if FECS_SIMD_AVX2
+            if constexpr (std::has_single_bit(PAGE_SIZE) && PAGE_SIZE > 1)
+            {
+                if (!IsHashed())
+                {
+                    i = FindPagedAvx2(entities, count, slots);
+                }
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                slots[i] = Find(GetEntityIndex(entities[i]));
+            }
+        }
+
+        inline auto Contains(std::uint32_t idx) const -> bool
+        {
+            return Find(idx) != NPOS;
+        }
+
+        /// @brief Maps an index that isn't mapped yet.
+        auto Link(std::uint32_t idx, std::uint32_t dense) -> void
+        {
+            assert(!Contains(idx) && "Index is already linked");
+            std::size_t p = idx / PAGE_SIZE;
+            if (p >= m_PageCounts.size())
+            {
+                m_PageCounts.resize(p + 1, 0);
+            }
+            if (m_PageCounts[p]++ == 0)
+            {
+                m_UsedPages++;
+            }
+            m_Size++;
+
+            if (IsHashed())
+            {
+                InsertHashed(idx, dense);
+                if (m_UsedPages * PAGE_SIZE <= m_Size * HASH_ENTRY_SLOTS)
+                {
+                    ToPages();
+                }
+            }
+            else
+            {
+                WritablePage(p)[idx % PAGE_SIZE] = dense;
+            }
+        }
+
+        /// @brief Points a mapped index at another dense position.
+        inline auto Relink(std::uint32_t idx, std::uint32_t dense) -> void
+        {
+            std::size_t p = idx / PAGE_SIZE;
+            if (p < m_Pages.size())
+            {
+                assert(m_Pages[p] != EmptyPage() && "Index isn't linked");
+                (*m_Pages[p])[idx % PAGE_SIZE] = dense;
+            }
+            else
+            {
+                m_Buckets[Locate(idx)].value = dense;
+            }
+        }
+
+        /// @brief Unmaps a mapped index, releasing its page when it was the last entry.
+        auto Unlink(std::uint32_t idx) -> void
+        {
+            assert(Contains(idx) && "Index isn't linked");
+            std::size_t p = idx / PAGE_SIZE;
+            m_Size--;
+            bool emptied = --m_PageCounts[p] == 0;
+            if (emptied)
+            {
+                m_UsedPages--;
+            }
+
+            if (IsHashed())
+            {
+                EraseHashed(idx);
+                if (m_Buckets.size() > MIN_BUCKETS && m_Size * 8 <= m_Buckets.size())
+                {
+                    Rehash(m_Buckets.size() / 2);
+                }
+                return;
+            }
+
+            (*m_Pages[p])[idx % PAGE_SIZE] = NPOS;
+            if (emptied)
+            {
+                ReleasePage(p);
+            }
+            if (m_UsedPages * PAGE_SIZE > m_Size * HASH_ENTRY_SLOTS * DEMOTE_RATIO)
+            {
+                ToHash();
+            }
+        }
+
+        /**
+         * @brief Makes room for count more entries whose indices are at most highest.
+         *
+         * Grows the page table or the hash map once instead of per Link().
+         */
+        auto Prepare(std::uint32_t highest, std::size_t count) -> void
+        {
+            std::size_t pages = highest / PAGE_SIZE + 1;
+            if (!IsHashed())
+            {
+                GrowTable(pages);
+            }
+            else if (std::min(pages, m_UsedPages + count) * PAGE_SIZE <= (m_Size + count) * HASH_ENTRY_SLOTS)
+            {
+                // The batch will promote the index anyway, skip growing the hash map first
+                ToPages();
+                GrowTable(pages);
+            }
+            else
+            {
+                ReserveHashed(m_Size + count);
+            }
+        }
+
+        /// @brief Unmaps every index, pages return to the page pool.
+        auto Clear() -> void
+        {
+            for (std::size_t p = 0; p < m_Pages.size(); ++p)
+            {
+                if (m_Pages[p] != EmptyPage())
+                {
+                    m_Pages[p]->fill(NPOS);
+                    ReleasePage(p);
+                }
+            }
+            m_Pages.clear();
+            m_Buckets.clear();
+            m_Buckets.shrink_to_fit();
+            m_PageCounts.clear();
+            m_Size = 0;
+            m_UsedPages = 0;
+        }
+
+        auto IsHashed() const -> bool
+        {
+            return m_Pages.empty();
+        }
+
+        auto Size() const -> std::size_t
+        {
+            return m_Size;
+        }
+
+        /// @brief Pages currently holding entries, zero while hashed.
+        auto PageCount() const -> std::size_t
+        {
+            return IsHashed() ? 0 : m_UsedPages;
+        }
+
+        /// @brief Heap bytes held by the index, pooled pages included.
+        auto MemoryUsage() const -> std::size_t
+        {
+            return m_Pages.capacity() * sizeof(Page*) +
+                   (PageCount() + m_FreePages.size()) * sizeof(Page) +
+                   m_FreePages.capacity() * sizeof(Page*) +
+                   m_Buckets.capacity() * sizeof(Bucket) +
+                   m_PageCounts.capacity() * sizeof(std::uint32_t);
+        }
+
+    private:
+        struct Bucket
+        {
+            std::uint32_t key = NPOS;
+            std::uint32_t value = NPOS;
+        };
+
+        static constexpr auto MakeEmptyPage() -> Page
+        {
+            Page page;
+            page.fill(NPOS);
+            return page;
+        }
+
+        /// @brief Shared by every index of this page size, never written to.
+        static constexpr Page EMPTY_PAGE = MakeEmptyPage();
+
+        static auto EmptyPage() -> Page*
+        {
+            return const_cast<Page*>(&EMPTY_PAGE);
+        }
+
+#if FECS_SIMD_AVX2
+        /// @brief The low 32 bits of four entities, which hold the index in every EntityTraits.
+        static inline auto LoadLowWords(const Entity* entities) -> __m128i
+        {
+            if constexpr (sizeof(Entity) == 4)
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(entities));
+            }
+            else
+            {
+                __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entities));
+                __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entities + 2));
+                return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high), _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+        }
+
+        /// @brief Vector part of FindBatch, returns how many entities it resolved.
+        inline auto FindPagedAvx2(const Entity* entities, std::size_t count, std::uint32_t* slots) const -> std::size_t
+        {
+            constexpr int PAGE_SHIFT = std::countr_zero(PAGE_SIZE);
+            const __m128i indexMask = _mm_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(INDEX_MASK)));
+            const __m128i offsetMask = _mm_set1_epi32(static_cast<int>(PAGE_SIZE - 1));
+            const __m128i pageCount = _mm_set1_epi32(static_cast<int>(m_Pages.size()));
+            const __m128i missing = _mm_set1_epi32(static_cast<int>(NPOS));
+            const auto* table = reinterpret_cast<const long long*>(m_Pages.data());
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i idx = _mm_and_si128(LoadLowWords(entities + i), indexMask);
+                __m128i page = _mm_srli_epi32(idx, PAGE_SHIFT);
+                // Indices past the table are unmapped, a paged index keeps no hash map
+                __m128i inTable = _mm_cmpgt_epi32(pageCount, page);
+
+                __m256i pages = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), table, page, _mm256_cvtepi32_epi64(inTable), 8);
+                __m256i offsets = _mm256_slli_epi64(_mm256_cvtepu32_epi64(_mm_and_si128(idx, offsetMask)), 2);
+                __m128i found = _mm256_mask_i64gather_epi32(missing, nullptr, _mm256_add_epi64(pages, offsets), inTable, 1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(slots + i), found);
+            }
+            return i;
+        }
+#endif
+
+        static inline auto Hash(std::uint32_t idx) -> std::size_t
+        {
+            std::uint32_t h = idx * 0x9E3779B1u;
+            return h ^ (h >> 16);
+        }
+
+        inline auto FindHashed(std::uint32_t idx) const -> std::uint32_t
+        {
+            std::size_t mask = m_Buckets.size() - 1;
+            for (std::size_t i = Hash(idx) & mask;; i = (i + 1) & mask)
+            {
+                const Bucket& bucket = m_Buckets[i];
+                if (bucket.key == idx)
+                {
+                    return bucket.value;
+                }
+                if (bucket.key == NPOS)
+                {
+                    return NPOS;
+                }
+            }
+        }
+
+        /// @brief Bucket of an index known to be in the hash map.
+        inline auto Locate(std::uint32_t idx) const -> std::size_t
+        {
+            std::size_t mask = m_Buckets.size() - 1;
+            std::size_t i = Hash(idx) & mask;
+            while (m_Buckets[i].key != idx)
+            {
+                i = (i + 1) & mask;
+            }
+            return i;
+        }
+
+        auto InsertHashed(std::uint32_t idx, std::uint32_t dense) -> void
+        {
+            ReserveHashed(m_Size);
+            std::size_t mask = m_Buckets.size() - 1;
+            std::size_t i = Hash(idx) & mask;
+            while (m_Buckets[i].key != NPOS)
+            {
+                i = (i + 1) & mask;
+            }
+            m_Buckets[i] = {idx, dense};
+        }
+
+        /// @brief Backward shift deletion, linear probing needs no tombstones.
+        auto EraseHashed(std::uint32_t idx) -> void
+        {
+            std::size_t mask = m_Buckets.size() - 1;
+            std::size_t hole = Locate(idx);
+            for (std::size_t i = (hole + 1) & mask; m_Buckets[i].key != NPOS; i = (i + 1) & mask)
+            {
+                std::size_t home = Hash(m_Buckets[i].key) & mask;
+                if (((i - home) & mask) >= ((i - hole) & mask))
+                {
+                    m_Buckets[hole] = m_Buckets[i];
+                    hole = i;
+                }
+            }
+            m_Buckets[hole] = Bucket{};
+        }
+
+        /// @brief Keeps the load factor at or below one half for entries hash map entries.
+        auto ReserveHashed(std::size_t entries) -> void
+        {
+            if (entries * 2 > m_Buckets.size())
+            {
+                Rehash(std::max(MIN_BUCKETS, std::bit_ceil(entries * 2)));
+            }
+        }
+
+        auto Rehash(std::size_t buckets) -> void
+        {
+            std::vector<Bucket> old(buckets);
+            old.swap(m_Buckets);
+
+            std::size_t mask = m_Buckets.size() - 1;
+            for (const Bucket& bucket : old)
+            {
+                if (bucket.key == NPOS)
+                {
+                    continue;
+                }
+
+                std::size_t i = Hash(bucket.key) & mask;
+                while (m_Buckets[i].key != NPOS)
+                {
+                    i = (i + 1) & mask;
+                }
+                m_Buckets[i] = bucket;
+            }
+        }
+
+        auto ToPages() -> void
+        {
+            std::vector<Bucket> entries;
+            entries.swap(m_Buckets);
+
+            GrowTable(m_PageCounts.size());
+            for (const Bucket& bucket : entries)
+            {
+                if (bucket.key != NPOS)
+                {
+                    WritablePage(bucket.key / PAGE_SIZE)[bucket.key % PAGE_SIZE] = bucket.value;
+                }
+            }
+        }
+
+        auto ToHash() -> void
+        {
+            std::vector<Page*> pages;
+            pages.swap(m_Pages);
+
+            Rehash(std::max(MIN_BUCKETS, std::bit_ceil(m_Size * 2)));
+            std::size_t mask = m_Buckets.size() - 1;
+            for (std::size_t p = 0; p < pages.size(); ++p)
+            {
+                Page* page = pages[p];
+                if (page == EmptyPage())
+                {
+                    continue;
+                }
+
+                for (std::size_t offset = 0; offset < PAGE_SIZE; ++offset)
+                {
+                    if ((*page)[offset] == NPOS)
+                    {
+                        continue;
+                    }
+
+                    std::uint32_t idx = static_cast<std::uint32_t>(p * PAGE_SIZE + offset);
+                    std::size_t i = Hash(idx) & mask;
+                    while (m_Buckets[i].key != NPOS)
+                    {
+                        i = (i + 1) & mask;
+                    }
+                    m_Buckets[i] = {idx, (*page)[offset]};
+                }
+
+                page->fill(NPOS);
+                PoolPage(page);
+            }
+        }
+
+        auto GrowTable(std::size_t pages) -> void
+        {
+            if (pages > m_Pages.size())
+            {
+                m_Pages.resize(pages, EmptyPage());
+            }
+        }
+
+        /// @brief Page p of the table, taken from the page pool when it's still the shared empty page.
+        inline auto WritablePage(std::size_t p) -> Page&
+        {
+            GrowTable(p + 1);
+            if (m_Pages[p] == EmptyPage())
+            {
+                if (m_FreePages.empty())
+                {
+                    m_Pages[p] = new Page(EMPTY_PAGE);
+                }
+                else
+                {
+                    m_Pages[p] = m_FreePages.back();
+                    m_FreePages.pop_back();
+                }
+            }
+            return *m_Pages[p];
+        }
+
+        /// @brief Hands page p, which must only hold NPOS, back to the page pool.
+        auto ReleasePage(std::size_t p) -> void
+        {
+            PoolPage(m_Pages[p]);
+            m_Pages[p] = EmptyPage();
+        }
+
+        auto PoolPage(Page* page) -> void
+        {
+            if (m_FreePages.size() < MAX_POOLED_PAGES)
+            {
+                m_FreePages.push_back(page);
+            }
+            else
+            {
+                delete page;
+            }
+        }
+
+        // Page table, empty while hashed
+        std::vector<Page*> m_Pages;
+        std::vector<Page*> m_FreePages;
+
+        // Hash map, empty while paged
+        std::vector<Bucket> m_Buckets;
+
+        // Entries per page, kept in both representations to decide when to switch
+        std::vector<std::uint32_t> m_PageCounts;
+        std::size_t m_UsedPages = 0;
+        std::size_t m_Size = 0;
+    };
+}
@@ -2,81 +2,162 @@
 #include <algorithm>
 #include <cassert>
 #include <array>
+#include <atomic>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "FECS/Containers/fast_vector.h"
+#include "FECS/Containers/paged_vector.h"
+#include "FECS/Containers/tag_vector.h"
+#include "FECS/Containers/IOwningGroup.h"
+#include "FECS/Containers/PresenceBitmap.h"
+#include "FECS/Containers/SparseIndex.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/Simd.h"
+#include "FECS/Core/SoA.h"
 #include "FECS/Core/Types.h"
 #include "FECS/Containers/ISparseSet.h"
 
 namespace FECS::Container
 {
+    /// @brief Dense container of a pool, picked from ComponentTraits<T>::storage.
+    template <typename T, StorageKind KIND = ComponentTraits<T>::storage>
+    struct DenseStorageOf
+    {
+        using Type = fast_vector<T, std::max(ComponentTraits<T>::alignment, alignof(T)), ComponentTraits<T>::growth>;
+    };
+
+    template <typename T>
+    struct DenseStorageOf<T, StorageKind::PAGED>
+    {
+        using Type = paged_vector<T, ComponentTraits<T>::pagedBlockSize, std::max(ComponentTraits<T>::alignment, alignof(T))>;
+    };
+
+    template <typename T>
+    struct DenseStorageOf<T, StorageKind::SOA>
+    {
+        using Type = SoAVector<T>;
+    };
+
     template <typename T>
     class SparseSet : public ISparseSet
     {
     public:
-        SparseSet()
-        {
-        }
+        /// @brief Whether the pool stamps added/changed ticks, see ComponentTraits::trackChanges.
+        static constexpr bool TRACKED = ComponentTraits<T>::trackChanges;
+
+        /// @brief Whether components live in fixed-size blocks that never move, see StorageKind::PAGED.
+        static constexpr bool PAGED = ComponentTraits<T>::storage == StorageKind::PAGED;
+
+        /// @brief Entity indices per sparse page, see ComponentTraits::sparsePageSize.
+        static constexpr std::size_t PAGE_SIZE = ComponentTraits<T>::sparsePageSize;
 
-        ~SparseSet()
+        static_assert(PAGE_SIZE > 0, "Sparse pages need at least one slot");
+
+        /// @brief Whether T is empty, the pool then keeps its entities but no component values, see IS_TAG_COMPONENT.
+        static constexpr bool TAG = IS_TAG_COMPONENT<T>;
+
+        /// @brief Whether every field lives in its own array, see StorageKind::SOA.
+        static constexpr bool SOA = IS_SOA_COMPONENT<T>;
+
+        /// @brief Whether the pool mirrors its entity indices into a PresenceBitmap, see ComponentTraits::presenceBitmap.
+        static constexpr bool PRESENCE = ComponentTraits<T>::presenceBitmap;
+
+        using DenseStorage = std::conditional_t<TAG, tag_vector<T>, typename DenseStorageOf<T>::Type>;
+
+        /// @brief What Get() hands out, T& or a SoARef<T> for SoA pools.
+        using Reference = ComponentRef<T>;
+        using ConstReference = ComponentRef<const T>;
+
+        /// @brief RemoveBatch compacts the pool once the batch is at least 1/BATCH_COMPACT_RATIO of it.
+        static constexpr std::size_t BATCH_COMPACT_RATIO = 8;
+
+        SparseSet()
         {
-            for (auto* page : m_Sparse)
-            {
-                delete page;
-            }
-            m_Sparse.clear();
         }
 
         inline auto Insert(Entity e, const T& component) -> void
         {
             std::uint32_t idx = FECS::GetEntityIndex(e);
-            auto& slot = SparseSlot(idx);
+            std::uint32_t slot = m_Sparse.Find(idx);
 
             if (slot == NPOS)
             {
-                slot = m_Dense.size();
+                assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+                m_Version++;
+                slot = static_cast<std::uint32_t>(m_Dense.size());
+                m_Sparse.Link(idx, slot);
+                MarkPresent(idx);
                 m_DenseEntities.push_back(e);
                 m_Dense.push_back(component);
+                StampInsert();
+                NotifyInsert(e);
             }
             else
             {
                 m_Dense[slot] = component;
+                StampChange(slot);
             }
         }
 
         inline auto Insert(Entity e, T&& component) -> void
         {
             std::uint32_t idx = FECS::GetEntityIndex(e);
-            auto& slot = SparseSlot(idx);
+            std::uint32_t slot = m_Sparse.Find(idx);
 
             if (slot == NPOS)
             {
-                slot = m_Dense.size();
+                assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+                m_Version++;
+                slot = static_cast<std::uint32_t>(m_Dense.size());
+                m_Sparse.Link(idx, slot);
+                MarkPresent(idx);
                 m_DenseEntities.push_back(e);
                 m_Dense.push_back(std::move(component));
+                StampInsert();
+                NotifyInsert(e);
             }
             else
             {
                 m_Dense[slot] = std::move(component);
+                StampChange(slot);
             }
         }
 
         template <typename... Args>
-        inline auto Emplace(Entity e, Args&... args) -> T&
+        inline auto Emplace(Entity e, Args&... args) -> Reference
         {
             std::uint32_t idx = FECS::GetEntityIndex(e);
-            auto& slot = SparseSlot(idx);
+            std::uint32_t slot = m_Sparse.Find(idx);
 
             if (slot == NPOS)
             {
-                slot = m_Dense.size();
+                assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+                m_Version++;
+                slot = static_cast<std::uint32_t>(m_Dense.size());
+                m_Sparse.Link(idx, slot);
+                MarkPresent(idx);
                 m_DenseEntities.push_back(std::move(e));
-                m_Dense.emplace_back(std::forward<Args>(args)...);
-                return m_Dense[slot];
+                if constexpr (std::is_trivial_v<T> && !PAGED && !SOA)
+                {
+                    m_Dense.push_back(T(std::forward<Args>(args)...));
+                }
+                else
+                {
+                    m_Dense.emplace_back(std::forward<Args>(args)...);
+                }
+                StampInsert();
+                NotifyInsert(e);
+                // A group may have moved the component into its prefix
+                return m_Dense[m_Sparse.Find(idx)];
             }
             else
             {
                 m_Dense[slot] = T(std::forward<Args>(args)...);
+                StampChange(slot);
                 return m_Dense[slot];
             }
         }
@@ -84,56 +165,187 @@ namespace FECS::Container
         inline virtual auto Remove(Entity e) -> void override
         {
             std::uint32_t idx = FECS::GetEntityIndex(e);
-            auto& slot = SparseSlot(idx);
+            std::uint32_t slot = m_Sparse.Find(idx);
 
             if (slot == NPOS)
                 return;
 
+            assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+            if (m_Group)
+            {
+                // Moves the entity out of the group's prefix, the swap-remove below then keeps it packed
+                m_Group->OnRemove(e);
+                slot = m_Sparse.Find(idx);
+            }
+            if (p_Signatures)
+            {
+                p_Signatures->Reset(e, m_ComponentIndex);
+            }
+            m_Version++;
             std::uint32_t last = m_Dense.size() - 1;
             if (slot != last)
             {
                 m_Dense[slot] = std::move(m_Dense[last]);
                 m_DenseEntities[slot] = m_DenseEntities[last];
-                SparseSlot(GetEntityIndex(m_DenseEntities[slot])) = slot;
+                m_Sparse.Relink(GetEntityIndex(m_DenseEntities[slot]), slot);
+                if constexpr (TRACKED)
+                {
+                    m_AddedTicks[slot] = m_AddedTicks[last];
+                    m_ChangedTicks[slot] = m_ChangedTicks[last];
+                }
             }
 
             m_Dense.pop_back();
             m_DenseEntities.pop_back();
-            slot = NPOS;
+            if constexpr (TRACKED)
+            {
+                m_AddedTicks.pop_back();
+                m_ChangedTicks.pop_back();
+            }
+            m_Sparse.Unlink(idx);
+            MarkAbsent(idx);
         }
 
-        inline auto Has(Entity e) -> bool
+        /**
+         * @brief Removes the components of several entities in a single pass over the dense arrays.
+         *
+         * Survivors keep their relative order. Batches small compared to the
+         * pool, and pools owned by a group, fall back to swap-and-pop per entity.
+         */
+        inline virtual auto RemoveBatch(std::span<const Entity> entities) -> void override
         {
-            uint32_t idx = GetEntityIndex(e);
-            uint32_t p = idx / SPARSE_PAGE_SIZE;
+            if (m_Group || entities.size() * BATCH_COMPACT_RATIO < m_Dense.size())
+            {
+                for (Entity e : entities)
+                {
+                    Remove(e);
+                }
+                return;
+            }
+
+            assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+            std::uint32_t first = static_cast<std::uint32_t>(m_Dense.size());
+            for (Entity e : entities)
+            {
+                std::uint32_t dense = DenseIndex(e);
+                if (dense == NPOS)
+                {
+                    continue;
+                }
+
+                // Tombstoned slots are dropped by the compaction below
+                m_Sparse.Unlink(GetEntityIndex(e));
+                MarkAbsent(GetEntityIndex(e));
+                m_DenseEntities[dense] = INVALID_ENTITY;
+                if (p_Signatures)
+                {
+                    p_Signatures->Reset(e, m_ComponentIndex);
+                }
+                first = std::min(first, dense);
+            }
 
-            if (p < m_Sparse.size() && m_Sparse[p])
+            if (first == m_Dense.size())
             {
-                uint32_t offset = idx % SPARSE_PAGE_SIZE;
-                return (*m_Sparse[p])[offset] != NPOS;
+                return;
+            }
+
+            // Everything before the first tombstone stays in place
+            m_Version++;
+            std::uint32_t write = first;
+            for (std::uint32_t read = first; read < m_Dense.size(); ++read)
+            {
+                Entity e = m_DenseEntities[read];
+                if (e == INVALID_ENTITY)
+                {
+                    continue;
+                }
+
+                if (write != read)
+                {
+                    m_Dense[write] = std::move(m_Dense[read]);
+                    m_DenseEntities[write] = e;
+                    m_Sparse.Relink(GetEntityIndex(e), write);
+                    if constexpr (TRACKED)
+                    {
+                        m_AddedTicks[write] = m_AddedTicks[read];
+                        m_ChangedTicks[write] = m_ChangedTicks[read];
+                    }
+                }
+                write++;
             }
 
-            return false;
+            Truncate(write);
         }
 
-        inline auto Get(Entity e) -> T&
+        inline auto Has(Entity e) const -> bool
+        {
+            if constexpr (PRESENCE)
+            {
+                return m_Presence.Test(GetEntityIndex(e));
+            }
+            else
+            {
+                return m_Sparse.Contains(GetEntityIndex(e));
+            }
+        }
+
+        inline auto Get(Entity e) -> Reference
         {
             assert(Has(e) && "Failed to retrive component, it doesn't exist on entity");
-            uint32_t idx = GetEntityIndex(e);
-            uint32_t p = idx / SPARSE_PAGE_SIZE;
-            uint32_t offset = idx % SPARSE_PAGE_SIZE;
-            uint32_t denseIdx = (*m_Sparse[p])[offset];
-            return m_Dense[denseIdx];
+            if constexpr (TAG)
+            {
+                // Every tag aliases the same instance, no need for the sparse lookup
+                return m_Dense[0];
+            }
+
+            return m_Dense[m_Sparse.Find(GetEntityIndex(e))];
         }
 
-        inline auto Get(Entity e) const -> const T&
+        inline auto Get(Entity e) const -> ConstReference
         {
             assert(Has(e) && "Failed to retrive component, it doesn't exist on entity");
-            uint32_t idx = GetEntityIndex(e);
-            uint32_t p = idx / SPARSE_PAGE_SIZE;
-            uint32_t offset = idx % SPARSE_PAGE_SIZE;
-            uint32_t denseIdx = (*m_Sparse[p])[offset];
-            return m_Dense[denseIdx];
+            if constexpr (TAG)
+            {
+                return m_Dense[0];
+            }
+
+            return m_Dense[m_Sparse.Find(GetEntityIndex(e))];
+        }
+
+        /// @brief Pointer to the entity's component, nullptr if it has none. SoA pools have no single address to hand out.
+        inline auto TryGet(Entity e) -> T*
+            requires(!SOA)
+        {
+            std::uint32_t slot = m_Sparse.Find(GetEntityIndex(e));
+            return slot == NPOS ? nullptr : &m_Dense[slot];
+        }
+
+        inline auto TryGet(Entity e) const -> const T*
+            requires(!SOA)
+        {
+            std::uint32_t slot = m_Sparse.Find(GetEntityIndex(e));
+            return slot == NPOS ? nullptr : &m_Dense[slot];
+        }
+
+        /// @brief Position of the entity's component in the dense array, NPOS if absent.
+        inline auto DenseIndex(Entity e) const -> std::uint32_t
+        {
+            return m_Sparse.Find(GetEntityIndex(e));
+        }
+
+        /// @brief DenseIndex() of count entities at once, see SparseIndex::FindBatch().
+        inline auto DenseIndices(const Entity* entities, std::size_t count, std::uint32_t* slots) const -> void
+        {
+            m_Sparse.FindBatch(entities, count, slots);
+        }
+
+        /// @brief Hints the component at the dense index into the cache, a no-op for tag and SoA pools.
+        inline auto PrefetchDense(std::uint32_t dense) const -> void
+        {
+            if constexpr (!TAG && !SOA)
+            {
+                FECS::Prefetch(&m_Dense[dense]);
+            }
         }
 
         inline auto Size() const -> std::size_t
@@ -146,41 +358,208 @@ namespace FECS::Container
             return m_DenseEntities[i];
         }
 
+        /// @brief The entity stored under an entity index known to be in the pool.
+        inline auto EntityOf(std::uint32_t idx) const -> Entity
+        {
+            return m_DenseEntities[m_Sparse.Find(idx)];
+        }
+
+        /// @brief One bit per entity index in the pool, see ComponentTraits::presenceBitmap.
+        inline auto GetPresence() const -> const PresenceBitmap&
+        {
+            static_assert(PRESENCE, "Pool keeps no presence bitmap, see ComponentTraits::presenceBitmap");
+            return m_Presence;
+        }
+
+        /// @brief Prepares the pool for amount entities with indices below amount.
         inline auto Reserve(std::size_t amount) -> void
         {
-            std::uint32_t numPages = (amount + SPARSE_PAGE_SIZE - 1) / SPARSE_PAGE_SIZE;
+            if (amount == 0)
+            {
+                return;
+            }
+
+            m_Sparse.Prepare(static_cast<std::uint32_t>(amount - 1), amount);
+            if constexpr (PRESENCE)
+            {
+                m_Presence.Prepare(static_cast<std::uint32_t>(amount - 1));
+            }
+            m_Dense.reserve(amount);
+            m_DenseEntities.reserve(amount);
+        }
+
+        /**
+         * @brief Makes room for count more components without intermediate regrowth.
+         *
+         * Capacity still grows geometrically so repeated small batches stay amortized.
+         */
+        inline auto ReserveAdditional(std::size_t count) -> void
+        {
+            std::size_t required = m_Dense.size() + count;
+            if (required > m_Dense.capacity())
+            {
+                m_Dense.reserve(std::max(required, m_Dense.capacity() * DenseStorage::grow_factor));
+            }
+            if (required > m_DenseEntities.capacity())
+            {
+                m_DenseEntities.reserve(std::max(required, m_DenseEntities.capacity() * fast_vector<Entity>::grow_factor));
+            }
+            if constexpr (TRACKED)
+            {
+                if (required > m_AddedTicks.capacity())
+                {
+                    m_AddedTicks.reserve(std::max(required, m_AddedTicks.capacity() * fast_vector<Tick>::grow_factor));
+                    m_ChangedTicks.reserve(std::max(required, m_ChangedTicks.capacity() * fast_vector<Tick>::grow_factor));
+                }
+            }
+        }
+
+        /**
+         * @brief Appends a component for each of several entities that don't have one yet.
+         *
+         * Storage is reserved once, then the dense arrays are filled in a single
+         * pass. fetch(i) produces the component of entities[i].
+         */
+        template <typename Fetch>
+        inline auto InsertBatch(std::span<const Entity> entities, Fetch&& fetch) -> void
+        {
+            if (entities.empty())
+            {
+                return;
+            }
 
-            if (m_Sparse.size() < numPages)
+            BeginBatch(entities);
+            for (std::size_t i = 0; i < entities.size(); ++i)
             {
-                size_t newSize = numPages;
-                size_t oldSize = m_Sparse.size();
-                m_Sparse.resize(newSize);
+                m_Dense.push_back(fetch(i));
+            }
+            LinkBatch(entities);
+        }
 
-                std::fill(m_Sparse.begin() + oldSize, m_Sparse.end(), nullptr);
+        /**
+         * @brief Appends a copy of prototype for each of several entities that don't have one yet.
+         *
+         * Trivial components are copied with memcpy into storage that is never
+         * default constructed. prototype must not live inside this pool.
+         */
+        inline auto FillBatch(std::span<const Entity> entities, const T& prototype) -> void
+        {
+            if (entities.empty())
+            {
+                return;
             }
 
-            for (std::size_t p = 0; p < numPages; ++p)
+            BeginBatch(entities);
+            if constexpr (TAG)
+            {
+                m_Dense.resize(m_Dense.size() + entities.size());
+            }
+            else if constexpr (std::is_trivial_v<T> && !SOA)
+            {
+                std::size_t begin = m_Dense.size();
+                m_Dense.resize(begin + entities.size());
+                for (std::size_t i = 0; i < entities.size(); ++i)
+                {
+                    std::memcpy(&m_Dense[begin + i], &prototype, sizeof(T));
+                }
+            }
+            else
             {
-                if (!m_Sparse[p])
+                for (std::size_t i = 0; i < entities.size(); ++i)
                 {
-                    m_Sparse[p] = new std::array<std::uint32_t, SPARSE_PAGE_SIZE>();
-                    m_Sparse[p]->fill(NPOS);
+                    m_Dense.push_back(prototype);
                 }
             }
+            LinkBatch(entities);
+        }
 
-            m_Dense.reserve(amount);
-            m_DenseEntities.reserve(amount);
+        inline virtual auto CloneBatch(Entity source, std::span<const Entity> targets) -> void override
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                // Copied out first, the batch may reallocate the dense array
+                const T prototype = Get(source);
+                FillBatch(targets, prototype);
+            }
+            else
+            {
+                assert(false && "Instantiating an entity requires copyable components");
+            }
         }
 
         inline virtual auto Clear() -> void override
         {
-            for (auto page : m_Sparse)
+            assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+            m_Version++;
+            m_Sparse.Clear();
+            m_Presence.Clear();
+            if (p_Signatures)
             {
-                if (page)
-                    page->fill(NPOS);
+                for (Entity e : m_DenseEntities)
+                {
+                    p_Signatures->Reset(e, m_ComponentIndex);
+                }
             }
             m_Dense.clear();
             m_DenseEntities.clear();
+            m_AddedTicks.clear();
+            m_ChangedTicks.clear();
+
+            if (m_Group)
+            {
+                m_Group->OnClear();
+            }
+        }
+
+        inline virtual auto GetMemoryUsage() const -> PoolMemory override
+        {
+            PoolMemory memory;
+            memory.dense = m_Dense.memory_usage();
+            memory.entities = m_DenseEntities.memory_usage() + m_AddedTicks.memory_usage() + m_ChangedTicks.memory_usage();
+            memory.sparse = m_Sparse.MemoryUsage();
+            memory.sparsePages = m_Sparse.PageCount();
+            memory.hashed = m_Sparse.IsHashed();
+            memory.presence = m_Presence.MemoryUsage();
+            return memory;
+        }
+
+        /**
+         * @brief Swaps two components in the dense array, keeping the sparse index consistent.
+         */
+        inline auto SwapDense(std::uint32_t a, std::uint32_t b) -> void
+        {
+            if (a == b)
+            {
+                return;
+            }
+
+            assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+            m_Version++;
+            // SoA pools hand out proxies, whose swap is found by ADL
+            using std::swap;
+            swap(m_Dense[a], m_Dense[b]);
+            std::swap(m_DenseEntities[a], m_DenseEntities[b]);
+            if constexpr (TRACKED)
+            {
+                std::swap(m_AddedTicks[a], m_AddedTicks[b]);
+                std::swap(m_ChangedTicks[a], m_ChangedTicks[b]);
+            }
+            m_Sparse.Relink(GetEntityIndex(m_DenseEntities[a]), a);
+            m_Sparse.Relink(GetEntityIndex(m_DenseEntities[b]), b);
+        }
+
+        /**
+         * @brief Hands the dense order of this pool over to a group, a pool can be owned by one group only.
+         */
+        inline auto SetOwningGroup(IOwningGroup* group) -> void
+        {
+            assert((!m_Group || !group) && "Pool is already owned by another group");
+            m_Group = group;
+        }
+
+        inline auto GetOwningGroup() const -> IOwningGroup*
+        {
+            return m_Group;
         }
 
         inline auto GetEntities() -> fast_vector<Entity>&
@@ -189,53 +568,206 @@ namespace FECS::Container
         }
 
         // Expose raw data for optimization
-        inline auto GetDataVector() -> fast_vector<T>&
+        inline auto GetDataVector() -> DenseStorage&
         {
             return m_Dense;
         }
 
+        /**
+         * @brief Indexable handle over the dense components, a plain pointer unless the pool is paged or a tag pool.
+         *
+         * Invalidated by structural changes.
+         */
+        inline auto GetDenseView()
+        {
+            if constexpr (PAGED || TAG)
+            {
+                return m_Dense.get_view();
+            }
+            else
+            {
+                return m_Dense.data();
+            }
+        }
+
+        /// @brief Number of components stored contiguously from the dense index on.
+        inline auto ContiguousRun(std::size_t dense) const -> std::size_t
+        {
+            if constexpr (PAGED || TAG)
+            {
+                return m_Dense.contiguous(dense);
+            }
+            else
+            {
+                return m_Dense.size() - dense;
+            }
+        }
+
+        /**
+         * @brief Sets the counter new and overwritten components are stamped with.
+         */
+        inline auto SetTickSource(const std::atomic<Tick>* tick) -> void
+        {
+            p_Tick = tick;
+        }
+
+        inline auto CurrentTick() const -> Tick
+        {
+            return p_Tick ? p_Tick->load(std::memory_order_relaxed) : 0;
+        }
+
+        /// @brief Tick at which the component at the dense index was attached.
+        inline auto GetAddedTick(std::uint32_t dense) const -> Tick
+        {
+            static_assert(TRACKED, "Component doesn't track changes, see ComponentTraits::trackChanges");
+            return m_AddedTicks[dense];
+        }
+
+        /// @brief Tick at which the component at the dense index was last attached or mutably accessed.
+        inline auto GetChangedTick(std::uint32_t dense) const -> Tick
+        {
+            static_assert(TRACKED, "Component doesn't track changes, see ComponentTraits::trackChanges");
+            return m_ChangedTicks[dense];
+        }
+
+        /// @brief Stamps the component at the dense index as changed, a no-op for untracked pools.
+        inline auto MarkChanged(std::uint32_t dense, Tick tick) -> void
+        {
+            if constexpr (TRACKED)
+            {
+                m_ChangedTicks[dense] = tick;
+            }
+        }
+
+        /**
+         * @brief Forbids structural changes (insertions of new entities, removals) until unlocked.
+         *
+         * Locks nest. Violations are caught by assertions in debug builds.
+         */
+        inline auto Lock() -> void
+        {
+            m_Locks.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline auto Unlock() -> void
+        {
+            [[maybe_unused]] std::uint32_t locks = m_Locks.fetch_sub(1, std::memory_order_relaxed);
+            assert(locks > 0 && "Unlocking a pool that isn't locked");
+        }
+
+        inline auto IsLocked() const -> bool
+        {
+            return m_Locks.load(std::memory_order_relaxed) > 0;
+        }
+
+    private:
+        inline auto BeginBatch(std::span<const Entity> entities) -> void
+        {
+            assert(!IsLocked() && "Structural change to a pool while it is being iterated in parallel");
+            m_Version++;
+            ReserveAdditional(entities.size());
+
+            // Grows the sparse index once for the whole batch
+            std::uint32_t highest = 0;
+            for (Entity e : entities)
+            {
+                highest = std::max(highest, GetEntityIndex(e));
+            }
+            m_Sparse.Prepare(highest, entities.size());
+            if constexpr (PRESENCE)
+            {
+                m_Presence.Prepare(highest);
+            }
+        }
+
+        /// @brief Links the components appended past m_DenseEntities to their entities.
+        inline auto LinkBatch(std::span<const Entity> entities) -> void
+        {
+            for (Entity e : entities)
+            {
+                assert(!Has(e) && "Batch insert of an entity that already has the component");
+                m_Sparse.Link(GetEntityIndex(e), static_cast<std::uint32_t>(m_DenseEntities.size()));
+                MarkPresent(GetEntityIndex(e));
+                m_DenseEntities.push_back(e);
+                StampInsert();
+                NotifyInsert(e);
+            }
+        }
+
     private:
-        auto SparseSlot(std::uint32_t idx) -> std::uint32_t&
+        inline auto Truncate(std::uint32_t size) -> void
         {
-            std::uint32_t p = GetPageIndex(idx);
-            if (p >= m_Sparse.size())
+            if (size == m_Dense.size())
             {
-                size_t newSize = p + 1;
-                size_t oldSize = m_Sparse.size();
-                m_Sparse.resize(newSize);
+                return;
+            }
 
-                std::fill(m_Sparse.begin() + oldSize, m_Sparse.end(), nullptr);
+            m_Dense.resize(size);
+            m_DenseEntities.resize(size);
+            if constexpr (TRACKED)
+            {
+                m_AddedTicks.resize(size);
+                m_ChangedTicks.resize(size);
             }
+        }
 
-            if (!m_Sparse[p])
+        inline auto MarkPresent(std::uint32_t idx) -> void
+        {
+            if constexpr (PRESENCE)
             {
-                m_Sparse[p] = new std::array<std::uint32_t, SPARSE_PAGE_SIZE>();
-                m_Sparse[p]->fill(NPOS);
+                m_Presence.Set(idx);
             }
+        }
 
-            return (*m_Sparse[p])[GetPageOffset(idx)];
+        inline auto MarkAbsent(std::uint32_t idx) -> void
+        {
+            if constexpr (PRESENCE)
+            {
+                m_Presence.Reset(idx);
+            }
         }
 
-        inline auto GetPageIndex(std::uint32_t idx) const -> const std::uint32_t
+        inline auto StampInsert() -> void
         {
-            return idx / SPARSE_PAGE_SIZE;
+            if constexpr (TRACKED)
+            {
+                Tick tick = CurrentTick();
+                m_AddedTicks.push_back(tick);
+                m_ChangedTicks.push_back(tick);
+            }
         }
 
-        inline auto GetPageOffset(std::uint32_t idx) const -> const std::uint32_t
+        inline auto StampChange(std::uint32_t slot) -> void
         {
-            return idx % SPARSE_PAGE_SIZE;
+            if constexpr (TRACKED)
+            {
+                m_ChangedTicks[slot] = CurrentTick();
+            }
         }
 
-        auto PageFor(std::uint32_t idx) -> std::array<std::uint32_t, SPARSE_PAGE_SIZE>*
+        inline auto NotifyInsert(Entity e) -> void
         {
-            std::uint32_t p = GetPageIndex(idx);
-            if (p >= m_Sparse.size())
-                return nullptr;
-            return m_Sparse[p];
+            if (p_Signatures)
+            {
+                p_Signatures->Set(e, m_ComponentIndex);
+            }
+
+            if (m_Group)
+            {
+                m_Group->OnInsert(e);
+            }
         }
 
-        fast_vector<T> m_Dense;
+        DenseStorage m_Dense;
         fast_vector<Entity> m_DenseEntities;
-        fast_vector<std::array<std::uint32_t, SPARSE_PAGE_SIZE>*> m_Sparse;
+        SparseIndex<PAGE_SIZE> m_Sparse;
+        PresenceBitmap m_Presence;
+        std::atomic<std::uint32_t> m_Locks = 0; ///< Atomic, systems reading the same data lock it from several threads
+        IOwningGroup* m_Group = nullptr;
+
+        // Parallel to m_Dense, only filled when TRACKED
+        fast_vector<Tick> m_AddedTicks;
+        fast_vector<Tick> m_ChangedTicks;
+        const std::atomic<Tick>* p_Tick = nullptr;
     };
 }
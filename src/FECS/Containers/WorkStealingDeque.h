@@ -0,0 +1,143 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace FECS::Container
+{
+    /**
+     * @brief Lock-free Chase-Lev work-stealing deque of pointers.
+     *
+     * The owning thread pushes and pops at the bottom (LIFO, cache friendly),
+     * any other thread may steal from the top (FIFO). The ring buffer grows on
+     * demand; retired rings are kept until destruction since thieves may still
+     * be reading from them.
+     */
+    template <typename T>
+    class WorkStealingDeque
+    {
+    private:
+        struct Ring
+        {
+            explicit Ring(std::int64_t capacity)
+                : capacity(capacity),
+                  mask(capacity - 1),
+                  slots(new std::atomic<T*>[capacity])
+            {
+            }
+
+            auto Load(std::int64_t i) const -> T*
+            {
+                return slots[i & mask].load(std::memory_order_relaxed);
+            }
+
+            auto Store(std::int64_t i, T* item) -> void
+            {
+                slots[i & mask].store(item, std::memory_order_relaxed);
+            }
+
+            auto Grow(std::int64_t bottom, std::int64_t top) const -> Ring*
+            {
+                Ring* bigger = new Ring(capacity * 2);
+                for (std::int64_t i = top; i < bottom; ++i)
+                {
+                    bigger->Store(i, Load(i));
+                }
+                return bigger;
+            }
+
+            std::int64_t capacity;
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<T*>[]> slots;
+        };
+
+    public:
+        explicit WorkStealingDeque(std::int64_t capacity = 256)
+        {
+            m_Rings.emplace_back(new Ring(capacity));
+            m_Ring.store(m_Rings.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /// @brief Owner only. Pushes an item to the bottom of the deque.
+        auto Push(T* item) -> void
+        {
+            std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            std::int64_t top = m_Top.load(std::memory_order_acquire);
+            Ring* ring = m_Ring.load(std::memory_order_relaxed);
+
+            if (bottom - top > ring->capacity - 1)
+            {
+                ring = ring->Grow(bottom, top);
+                m_Rings.emplace_back(ring);
+                m_Ring.store(ring, std::memory_order_release);
+            }
+
+            ring->Store(bottom, item);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        /// @brief Owner only. Pops the most recently pushed item, or nullptr if empty.
+        auto Pop() -> T*
+        {
+            std::int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Ring* ring = m_Ring.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_seq_cst);
+            std::int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+            if (top > bottom)
+            {
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = ring->Load(bottom);
+            if (top == bottom)
+            {
+                // Last item, race against thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    item = nullptr;
+                }
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /// @brief Any thread. Steals the oldest item, or nullptr if empty or lost a race.
+        auto Steal() -> T*
+        {
+            std::int64_t top = m_Top.load(std::memory_order_seq_cst);
+            std::int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            Ring* ring = m_Ring.load(std::memory_order_acquire);
+            T* item = ring->Load(top);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return nullptr;
+            }
+
+            return item;
+        }
+
+        auto Empty() const -> bool
+        {
+            return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::int64_t> m_Top = 0;
+        std::atomic<std::int64_t> m_Bottom = 0;
+        std::atomic<Ring*> m_Ring = nullptr;
+        std::vector<std::unique_ptr<Ring>> m_Rings;
+    };
+}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring> // std::memcpy()
 #include <new>
 #include <type_traits>
+#include <utility>
 
 // Helper functions
 
@@ -29,6 +31,17 @@ inline auto copy_range(T* begin, T* end, T* dest) -> void
     }
 }
 
+template <class T>
+inline auto move_range(T* begin, T* end, T* dest) -> void
+{
+    while (begin != end)
+    {
+        new (dest) T(std::move(*begin));
+        begin++;
+        dest++;
+    }
+}
+
 template <class T>
 inline auto destruct_range(T* begin, T* end) -> void
 {
@@ -39,7 +52,13 @@ inline auto destruct_range(T* begin, T* end) -> void
     }
 }
 
-template <class T>
+/**
+ * @brief Growable array for trivially relocatable elements.
+ *
+ * @tparam Alignment Alignment of the first element, raised to alignof(T) when smaller.
+ * @tparam GrowFactor Factor the capacity is multiplied by when the vector is full.
+ */
+template <class T, std::size_t Alignment = alignof(T), std::size_t GrowFactor = 2>
 class fast_vector
 {
 public:
@@ -82,6 +101,9 @@ public:
     auto capacity() const noexcept -> size_type;
     auto shrink_to_fit() -> void;
 
+    /// @brief Heap bytes held by the elements, used or not.
+    auto memory_usage() const noexcept -> size_type;
+
     // Modifiers
 
     auto clear() noexcept -> void;
@@ -95,23 +117,34 @@ public:
     auto pop_back() -> void;
     auto resize(size_type count) -> void;
 
-    static constexpr size_type grow_factor = 2;
+    static constexpr size_type grow_factor = GrowFactor;
+    static constexpr size_type alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    static_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(grow_factor >= 2, "Growing by less than a factor of two loses the amortized constant push_back");
 
 private:
+    /// @brief malloc() already satisfies fundamental alignments and lets trivial types use realloc().
+    static constexpr bool over_aligned = alignment > alignof(std::max_align_t);
+
+    static auto allocate(size_type count) -> T*;
+    static auto deallocate(T* data) -> void;
+    static auto reallocate(T* data, size_type size, size_type count) -> T*;
+
     T* m_data = nullptr;
     size_type m_size = 0;
     size_type m_capacity = 0;
 };
 
-template <class T>
-fast_vector<T>::fast_vector(const fast_vector& other)
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+fast_vector<T, Alignment, GrowFactor>::fast_vector(const fast_vector& other)
     : m_size(other.m_size), m_capacity(other.m_capacity)
 {
-    m_data = reinterpret_cast<T*>(std::malloc(sizeof(T) * other.m_capacity));
+    m_data = allocate(other.m_capacity);
 
-    if (std::is_trivial_v<T>)
+    if constexpr (std::is_trivial_v<T>)
     {
-        std::memcpy(m_data, other.m_data, other.m_size);
+        std::memcpy(m_data, other.m_data, sizeof(T) * other.m_size);
     }
     else
     {
@@ -119,24 +152,34 @@ fast_vector<T>::fast_vector(const fast_vector& other)
     }
 }
 
-template <class T>
-fast_vector<T>::fast_vector(fast_vector&& other) noexcept
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+fast_vector<T, Alignment, GrowFactor>::fast_vector(fast_vector&& other) noexcept
     : m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity)
 {
     other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
 }
 
-template <class T>
-fast_vector<T>& fast_vector<T>::operator=(const fast_vector& other)
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+fast_vector<T, Alignment, GrowFactor>& fast_vector<T, Alignment, GrowFactor>::operator=(const fast_vector& other)
 {
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    clear();
+    deallocate(m_data);
+
     m_size = other.m_size;
     m_capacity = other.m_capacity;
 
-    m_data = reinterpret_cast<T*>(std::malloc(sizeof(T) * other.m_capacity));
+    m_data = allocate(other.m_capacity);
 
-    if (std::is_trivial_v<T>)
+    if constexpr (std::is_trivial_v<T>)
     {
-        std::memcpy(m_data, other.m_data, other.m_size);
+        std::memcpy(m_data, other.m_data, sizeof(T) * other.m_size);
     }
     else
     {
@@ -146,144 +189,207 @@ fast_vector<T>& fast_vector<T>::operator=(const fast_vector& other)
     return *this;
 }
 
-template <class T>
-fast_vector<T>& fast_vector<T>::operator=(fast_vector&& other) noexcept
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+fast_vector<T, Alignment, GrowFactor>& fast_vector<T, Alignment, GrowFactor>::operator=(fast_vector&& other) noexcept
 {
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    clear();
+    deallocate(m_data);
+
     m_data = other.m_data;
     m_size = other.m_size;
     m_capacity = other.m_capacity;
 
     other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
 
     return *this;
 }
 
-template <class T>
-fast_vector<T>::~fast_vector()
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+fast_vector<T, Alignment, GrowFactor>::~fast_vector()
 {
     if (!std::is_trivial_v<T>)
     {
         destruct_range(begin(), end());
     }
 
-    std::free(m_data);
+    deallocate(m_data);
+}
+
+// Allocation
+
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::allocate(size_type count) -> T*
+{
+    if constexpr (over_aligned)
+    {
+        return static_cast<T*>(::operator new(sizeof(T) * count, std::align_val_t(alignment)));
+    }
+    else
+    {
+        return reinterpret_cast<T*>(std::malloc(sizeof(T) * count));
+    }
+}
+
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::deallocate(T* data) -> void
+{
+    if constexpr (over_aligned)
+    {
+        ::operator delete(data, std::align_val_t(alignment));
+    }
+    else
+    {
+        std::free(data);
+    }
+}
+
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::reallocate(T* data, size_type size, size_type count) -> T*
+{
+    static_assert(std::is_trivial_v<T>, "Only trivial types can be reallocated bytewise");
+
+    if constexpr (over_aligned)
+    {
+        T* new_data = allocate(count);
+        if (data)
+        {
+            std::memcpy(new_data, data, sizeof(T) * size);
+        }
+        deallocate(data);
+        return new_data;
+    }
+    else
+    {
+        return reinterpret_cast<T*>(std::realloc(data, sizeof(T) * count));
+    }
 }
 
 // Element access
 
-template <class T>
-auto fast_vector<T>::operator[](size_type pos) -> T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::operator[](size_type pos) -> T&
 {
     assert(pos < m_size && "Position is out of range");
     return m_data[pos];
 }
 
-template <class T>
-auto fast_vector<T>::operator[](size_type pos) const -> const T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::operator[](size_type pos) const -> const T&
 {
     assert(pos < m_size && "Position is out of range");
     return m_data[pos];
 }
 
-template <class T>
-auto fast_vector<T>::front() -> T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::front() -> T&
 {
     assert(m_size > 0 && "Container is empty");
     return m_data[0];
 }
 
-template <class T>
-auto fast_vector<T>::front() const -> const T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::front() const -> const T&
 {
     assert(m_size > 0 && "Container is empty");
     return m_data[0];
 }
 
-template <class T>
-auto fast_vector<T>::back() -> T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::back() -> T&
 {
     assert(m_size > 0 && "Container is empty");
     return m_data[m_size - 1];
 }
 
-template <class T>
-auto fast_vector<T>::back() const -> const T&
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::back() const -> const T&
 {
     assert(m_size > 0 && "Container is empty");
     return m_data[m_size - 1];
 }
 
-template <class T>
-auto fast_vector<T>::data() noexcept -> T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::data() noexcept -> T*
 {
     return m_data;
 }
 
-template <class T>
-auto fast_vector<T>::data() const noexcept -> const T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::data() const noexcept -> const T*
 {
     return m_data;
 }
 
 // Iterators
 
-template <class T>
-auto fast_vector<T>::begin() noexcept -> T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::begin() noexcept -> T*
 {
     return m_data;
 }
 
-template <class T>
-auto fast_vector<T>::begin() const noexcept -> const T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::begin() const noexcept -> const T*
 {
     return m_data;
 }
 
-template <class T>
-auto fast_vector<T>::end() noexcept -> T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::end() noexcept -> T*
 {
     return m_data + m_size;
 }
 
-template <class T>
-auto fast_vector<T>::end() const noexcept -> const T*
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::end() const noexcept -> const T*
 {
     return m_data + m_size;
 }
 
 // Capacity
 
-template <class T>
-auto fast_vector<T>::empty() const noexcept -> bool
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::empty() const noexcept -> bool
 {
     return m_size == 0;
 }
 
-template <class T>
-auto fast_vector<T>::size() const noexcept -> typename fast_vector<T>::size_type
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::size() const noexcept -> typename fast_vector<T, Alignment, GrowFactor>::size_type
 {
     return m_size;
 }
 
-template <class T>
-auto fast_vector<T>::reserve(size_type new_cap) -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::reserve(size_type new_cap) -> void
 {
-    assert(new_cap > m_capacity && "Capacity is already equal to or greater than the passed value");
+    if (new_cap <= m_capacity)
+    {
+        return;
+    }
 
     if constexpr (std::is_trivial_v<T>)
     {
-        m_data = reinterpret_cast<T*>(std::realloc(m_data, sizeof(T) * new_cap));
+        m_data = reallocate(m_data, m_size, new_cap);
         assert(m_data != nullptr && "Reallocation failed");
     }
     else
     {
-        T* new_data_location = reinterpret_cast<T*>(std::malloc(sizeof(T) * new_cap));
+        T* new_data_location = allocate(new_cap);
         assert(new_data_location != nullptr && "Allocation failed");
 
-        copy_range(begin(), end(), new_data_location);
+        // Relocating never needs a copy, the old elements are destroyed right after
+        move_range(begin(), end(), new_data_location);
         destruct_range(begin(), end());
 
-        std::free(m_data);
+        deallocate(m_data);
 
         m_data = new_data_location;
     }
@@ -291,41 +397,57 @@ auto fast_vector<T>::reserve(size_type new_cap) -> void
     m_capacity = new_cap;
 }
 
-template <class T>
-auto fast_vector<T>::capacity() const noexcept -> typename fast_vector<T>::size_type
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::capacity() const noexcept -> typename fast_vector<T, Alignment, GrowFactor>::size_type
 {
     return m_capacity;
 }
 
-template <class T>
-auto fast_vector<T>::shrink_to_fit() -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::memory_usage() const noexcept -> typename fast_vector<T, Alignment, GrowFactor>::size_type
+{
+    return m_capacity * sizeof(T);
+}
+
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::shrink_to_fit() -> void
 {
+    if (m_size == 0)
+    {
+        deallocate(m_data);
+        m_data = nullptr;
+        m_capacity = 0;
+        return;
+    }
+
     if (m_size < m_capacity)
     {
         if constexpr (std::is_trivial_v<T>)
         {
-            m_data = reinterpret_cast<T*>(std::realloc(m_data, sizeof(T) * m_size));
+            m_data = reallocate(m_data, m_size, m_size);
             assert(m_data != nullptr && "Reallocation failed");
         }
         else
         {
-            T* new_data_location = reinterpret_cast<T*>(std::malloc(sizeof(T) * m_size));
+            T* new_data_location = allocate(m_size);
             assert(new_data_location != nullptr && "Allocation failed");
 
-            copy_range(begin(), end(), new_data_location);
+            move_range(begin(), end(), new_data_location);
             destruct_range(begin(), end());
 
-            std::free(m_data);
+            deallocate(m_data);
 
             m_data = new_data_location;
         }
+
+        m_capacity = m_size;
     }
 }
 
 // Modifiers
 
-template <class T>
-auto fast_vector<T>::clear() noexcept -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::clear() noexcept -> void
 {
     if constexpr (!std::is_trivial_v<T>)
     {
@@ -335,8 +457,8 @@ auto fast_vector<T>::clear() noexcept -> void
     m_size = 0;
 }
 
-template <class T>
-auto fast_vector<T>::push_back(const T& value) -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::push_back(const T& value) -> void
 {
     if (m_size == m_capacity)
     {
@@ -355,8 +477,8 @@ auto fast_vector<T>::push_back(const T& value) -> void
     m_size++;
 }
 
-template <class T>
-auto fast_vector<T>::push_back(T&& value) -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::push_back(T&& value) -> void
 {
     if (m_size == m_capacity)
     {
@@ -375,9 +497,9 @@ auto fast_vector<T>::push_back(T&& value) -> void
     m_size++;
 }
 
-template <class T>
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
 template <class... Args>
-auto fast_vector<T>::emplace_back(Args&&... args) -> void
+auto fast_vector<T, Alignment, GrowFactor>::emplace_back(Args&&... args) -> void
 {
     static_assert(!std::is_trivial_v<T>, "Use push_back() instead of emplace_back() with trivial types");
 
@@ -391,8 +513,8 @@ auto fast_vector<T>::emplace_back(Args&&... args) -> void
     m_size++;
 }
 
-template <class T>
-auto fast_vector<T>::pop_back() -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::pop_back() -> void
 {
     assert(m_size > 0 && "Container is empty");
 
@@ -404,11 +526,9 @@ auto fast_vector<T>::pop_back() -> void
     m_size--;
 }
 
-template <class T>
-auto fast_vector<T>::resize(size_type count) -> void
+template <class T, std::size_t Alignment, std::size_t GrowFactor>
+auto fast_vector<T, Alignment, GrowFactor>::resize(size_type count) -> void
 {
-    assert(count != m_size && "Size is already equal to the passed value");
-
     if (count > m_capacity)
     {
         reserve(count);
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Vector storing its elements in fixed-size blocks that are never relocated.
+ *
+ * Growing allocates one more block instead of moving the elements, so the
+ * address of an element stays valid until it is popped. Elements are only
+ * contiguous within a block, see contiguous().
+ *
+ * @tparam BlockBytes Target size of one block, rounded down to a power of two elements.
+ * @tparam Alignment Alignment of every block, raised to alignof(T) when smaller.
+ */
+template <class T, std::size_t BlockBytes, std::size_t Alignment = alignof(T)>
+class paged_vector
+{
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type block_size = std::bit_floor(std::max<size_type>(1, BlockBytes / sizeof(T)));
+    static constexpr size_type alignment = std::max(Alignment, alignof(T));
+
+    static_assert(std::has_single_bit(alignment), "Alignment must be a power of two");
+
+    /// @brief Reserving adds blocks on demand, there is nothing to amortize.
+    static constexpr size_type grow_factor = 1;
+
+    /// @brief Indexable handle over the blocks, invalidated when a block is added.
+    class view
+    {
+    public:
+        explicit view(T* const* blocks)
+            : m_blocks(blocks)
+        {
+        }
+
+        inline auto operator[](size_type pos) const -> T&
+        {
+            return m_blocks[pos / block_size][pos % block_size];
+        }
+
+    private:
+        T* const* m_blocks;
+    };
+
+    paged_vector() = default;
+    paged_vector(const paged_vector&) = delete;
+    paged_vector& operator=(const paged_vector&) = delete;
+
+    ~paged_vector()
+    {
+        clear();
+        for (T* block : m_blocks)
+        {
+            ::operator delete(block, std::align_val_t(alignment));
+        }
+    }
+
+    // Element access
+
+    inline auto operator[](size_type pos) -> T&
+    {
+        assert(pos < m_size && "Position is out of range");
+        return m_blocks[pos / block_size][pos % block_size];
+    }
+
+    inline auto operator[](size_type pos) const -> const T&
+    {
+        assert(pos < m_size && "Position is out of range");
+        return m_blocks[pos / block_size][pos % block_size];
+    }
+
+    auto back() -> T&
+    {
+        assert(m_size > 0 && "Container is empty");
+        return (*this)[m_size - 1];
+    }
+
+    auto get_view() noexcept -> view
+    {
+        return view(m_blocks.data());
+    }
+
+    /// @brief Number of elements stored contiguously from pos on, at most up to the end of its block.
+    auto contiguous(size_type pos) const noexcept -> size_type
+    {
+        return std::min(m_size - pos, block_size - pos % block_size);
+    }
+
+    // Capacity
+
+    auto empty() const noexcept -> bool
+    {
+        return m_size == 0;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    auto capacity() const noexcept -> size_type
+    {
+        return m_blocks.size() * block_size;
+    }
+
+    /// @brief Heap bytes held by the blocks and the block table.
+    auto memory_usage() const noexcept -> size_type
+    {
+        return capacity() * sizeof(T) + m_blocks.capacity() * sizeof(T*);
+    }
+
+    auto reserve(size_type new_cap) -> void
+    {
+        while (capacity() < new_cap)
+        {
+            m_blocks.push_back(static_cast<T*>(::operator new(sizeof(T) * block_size, std::align_val_t(alignment))));
+        }
+    }
+
+    // Modifiers
+
+    auto clear() noexcept -> void
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                (*this)[i].~T();
+            }
+        }
+
+        m_size = 0;
+    }
+
+    auto push_back(const T& value) -> void
+    {
+        emplace_back(value);
+    }
+
+    auto push_back(T&& value) -> void
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        reserve(m_size + 1);
+        new (&m_blocks[m_size / block_size][m_size % block_size]) T(std::forward<Args>(args)...);
+        m_size++;
+    }
+
+    auto pop_back() -> void
+    {
+        assert(m_size > 0 && "Container is empty");
+        m_size--;
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            m_blocks[m_size / block_size][m_size % block_size].~T();
+        }
+    }
+
+    /// @brief Trivial elements are left uninitialized when growing, like fast_vector.
+    auto resize(size_type count) -> void
+    {
+        reserve(count);
+        while (m_size > count)
+        {
+            pop_back();
+        }
+
+        if constexpr (std::is_trivial_v<T>)
+        {
+            m_size = count;
+        }
+        else
+        {
+            while (m_size < count)
+            {
+                emplace_back();
+            }
+        }
+    }
+
+private:
+    std::vector<T*> m_blocks;
+    size_type m_size = 0;
+};
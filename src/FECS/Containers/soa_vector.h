@@ -0,0 +1,365 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "FECS/Containers/fast_vector.h"
+
+/// @brief Splits a pointer to data member into its class and field type.
+template <class M>
+struct soa_member;
+
+template <class C, class F>
+struct soa_member<F C::*>
+{
+    using owner = C;
+    using type = F;
+};
+
+/**
+ * @brief Vector of T stored as one array per field (struct of arrays).
+ *
+ * Elements are scattered into the field arrays on insertion and gathered back
+ * into a T on demand. Indexing returns a proxy reference whose fields are
+ * reached with get<&T::field>(), data() returns a proxy pointer exposing the
+ * field arrays, e.g. for SIMD over a single field.
+ *
+ * @tparam Alignment Alignment of every field array.
+ * @tparam Members Pointers to the data members of T, every member T carries state in.
+ */
+template <class T, std::size_t Alignment, auto... Members>
+class soa_vector
+{
+    static_assert(sizeof...(Members) > 0, "A struct of arrays needs at least one field");
+    static_assert((std::is_same_v<typename soa_member<decltype(Members)>::owner, T> && ...), "Every field must be a data member of T");
+    static_assert(std::is_default_constructible_v<T>, "Gathering an element default constructs it first");
+
+    template <auto Member>
+    using field_t = typename soa_member<decltype(Member)>::type;
+
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type grow_factor = 2;
+    static constexpr size_type field_count = sizeof...(Members);
+
+    /// @brief Position of Member in the field list.
+    template <auto Member>
+    static constexpr auto index_of() -> size_type
+    {
+        size_type index = 0;
+        size_type found = field_count;
+        ((same_member<Member, Members>() ? found = index : 0, ++index), ...);
+        return found;
+    }
+
+    template <bool Const>
+    class basic_reference;
+
+    /**
+     * @brief Pointer to an element, with direct access to the field arrays from there on.
+     */
+    template <bool Const>
+    class basic_pointer
+    {
+    public:
+        using pointers = std::tuple<std::conditional_t<Const, const field_t<Members>*, field_t<Members>*>...>;
+
+        basic_pointer() = default;
+
+        explicit basic_pointer(pointers fields)
+            : m_fields(fields)
+        {
+        }
+
+        /// @brief The array of the field Member, e.g. get<&Position::x>().
+        template <auto Member>
+        auto get() const
+        {
+            static_assert(index_of<Member>() < field_count, "Member isn't part of the field list");
+            return std::get<index_of<Member>()>(m_fields);
+        }
+
+        template <size_type I>
+        auto field() const
+        {
+            return std::get<I>(m_fields);
+        }
+
+        auto operator[](size_type pos) const -> basic_reference<Const>
+        {
+            return (*this + pos).deref();
+        }
+
+        auto operator+(size_type offset) const -> basic_pointer
+        {
+            return basic_pointer(std::apply([offset](auto*... field)
+            {
+                return pointers(field + offset...);
+            }, m_fields));
+        }
+
+        operator basic_pointer<true>() const
+            requires(!Const)
+        {
+            return basic_pointer<true>(typename basic_pointer<true>::pointers(m_fields));
+        }
+
+    private:
+        auto deref() const -> basic_reference<Const>
+        {
+            return basic_reference<Const>(m_fields);
+        }
+
+        pointers m_fields;
+    };
+
+    /**
+     * @brief Proxy reference to an element, scattering and gathering the fields.
+     *
+     * Copies refer to the same element, assigning a reference or a T assigns
+     * the field values like a real reference would.
+     */
+    template <bool Const>
+    class basic_reference
+    {
+    public:
+        using pointers = typename basic_pointer<Const>::pointers;
+
+        explicit basic_reference(pointers fields)
+            : m_fields(fields)
+        {
+        }
+
+        basic_reference(const basic_reference&) = default;
+
+        /// @brief The field Member of the element, e.g. get<&Position::x>().
+        template <auto Member>
+        auto get() const -> decltype(auto)
+        {
+            static_assert(index_of<Member>() < field_count, "Member isn't part of the field list");
+            return *std::get<index_of<Member>()>(m_fields);
+        }
+
+        template <size_type I>
+        auto field() const -> decltype(auto)
+        {
+            return *std::get<I>(m_fields);
+        }
+
+        /// @brief Gathers a copy of the element.
+        operator T() const
+        {
+            T value{};
+            gather(value, std::make_index_sequence<field_count>{});
+            return value;
+        }
+
+        auto operator=(const T& value) const -> const basic_reference&
+            requires(!Const)
+        {
+            scatter(value, std::make_index_sequence<field_count>{});
+            return *this;
+        }
+
+        auto operator=(const basic_reference& other) const -> const basic_reference&
+            requires(!Const)
+        {
+            assign(other, std::make_index_sequence<field_count>{});
+            return *this;
+        }
+
+        operator basic_reference<true>() const
+            requires(!Const)
+        {
+            return basic_reference<true>(typename basic_reference<true>::pointers(m_fields));
+        }
+
+        auto operator&() const -> basic_pointer<Const>
+        {
+            return basic_pointer<Const>(m_fields);
+        }
+
+        /// @brief Swaps the values of two elements, found by ADL like std::swap for real references.
+        friend auto swap(basic_reference a, basic_reference b) -> void
+            requires(!Const)
+        {
+            a.swap_with(b, std::make_index_sequence<field_count>{});
+        }
+
+    private:
+        template <size_type... I>
+        auto gather(T& value, std::index_sequence<I...>) const -> void
+        {
+            ((value.*Members = *std::get<I>(m_fields)), ...);
+        }
+
+        template <size_type... I>
+        auto scatter(const T& value, std::index_sequence<I...>) const -> void
+        {
+            ((*std::get<I>(m_fields) = value.*Members), ...);
+        }
+
+        template <size_type... I>
+        auto assign(const basic_reference& other, std::index_sequence<I...>) const -> void
+        {
+            ((*std::get<I>(m_fields) = *std::get<I>(other.m_fields)), ...);
+        }
+
+        template <size_type... I>
+        auto swap_with(basic_reference& other, std::index_sequence<I...>) const -> void
+        {
+            using std::swap;
+            (swap(*std::get<I>(m_fields), *std::get<I>(other.m_fields)), ...);
+        }
+
+        pointers m_fields;
+    };
+
+    using reference = basic_reference<false>;
+    using const_reference = basic_reference<true>;
+    using pointer = basic_pointer<false>;
+    using const_pointer = basic_pointer<true>;
+
+    // Element access
+
+    auto operator[](size_type pos) -> reference
+    {
+        assert(pos < size() && "Position is out of range");
+        return data()[pos];
+    }
+
+    auto operator[](size_type pos) const -> const_reference
+    {
+        assert(pos < size() && "Position is out of range");
+        return data()[pos];
+    }
+
+    auto back() -> reference
+    {
+        assert(!empty() && "Container is empty");
+        return (*this)[size() - 1];
+    }
+
+    auto data() noexcept -> pointer
+    {
+        return pointer(std::apply([](auto&... field)
+        {
+            return typename pointer::pointers(field.data()...);
+        }, m_fields));
+    }
+
+    auto data() const noexcept -> const_pointer
+    {
+        return const_pointer(std::apply([](const auto&... field)
+        {
+            return typename const_pointer::pointers(field.data()...);
+        }, m_fields));
+    }
+
+    // Capacity
+
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return std::get<0>(m_fields).size();
+    }
+
+    auto capacity() const noexcept -> size_type
+    {
+        return std::get<0>(m_fields).capacity();
+    }
+
+    /// @brief Heap bytes held by all field arrays.
+    auto memory_usage() const noexcept -> size_type
+    {
+        return std::apply([](const auto&... field)
+        {
+            return (field.memory_usage() + ...);
+        }, m_fields);
+    }
+
+    auto reserve(size_type new_cap) -> void
+    {
+        std::apply([new_cap](auto&... field)
+        {
+            (field.reserve(new_cap), ...);
+        }, m_fields);
+    }
+
+    auto shrink_to_fit() -> void
+    {
+        std::apply([](auto&... field)
+        {
+            (field.shrink_to_fit(), ...);
+        }, m_fields);
+    }
+
+    // Modifiers
+
+    auto clear() noexcept -> void
+    {
+        std::apply([](auto&... field)
+        {
+            (field.clear(), ...);
+        }, m_fields);
+    }
+
+    auto push_back(const T& value) -> void
+    {
+        push_back(value, std::make_index_sequence<field_count>{});
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        push_back(T(std::forward<Args>(args)...));
+    }
+
+    auto pop_back() -> void
+    {
+        assert(!empty() && "Container is empty");
+        std::apply([](auto&... field)
+        {
+            (field.pop_back(), ...);
+        }, m_fields);
+    }
+
+    /// @brief Trivial fields are left uninitialized when growing, like fast_vector.
+    auto resize(size_type count) -> void
+    {
+        std::apply([count](auto&... field)
+        {
+            (field.resize(count), ...);
+        }, m_fields);
+    }
+
+private:
+    template <auto A, auto B>
+    static constexpr auto same_member() -> bool
+    {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+        {
+            return A == B;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <size_type... I>
+    auto push_back(const T& value, std::index_sequence<I...>) -> void
+    {
+        (std::get<I>(m_fields).push_back(value.*Members), ...);
+    }
+
+    std::tuple<fast_vector<field_t<Members>, Alignment>...> m_fields;
+};
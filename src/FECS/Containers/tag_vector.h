@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Stand-in for the dense array of an empty type, only counting its elements.
+ *
+ * Empty types carry no state, so every element aliases one shared block of
+ * block_size instances instead of owning storage. References handed out stay
+ * valid forever and writes through them are no-ops. Elements are contiguous
+ * up to the end of the shared block, see contiguous().
+ */
+template <class T>
+class tag_vector
+{
+    static_assert(std::is_empty_v<T> && std::is_trivial_v<T>, "tag_vector only stores trivial empty types");
+
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type block_size = 1024;
+
+    /// @brief Nothing is allocated, growing only bumps the size.
+    static constexpr size_type grow_factor = 1;
+
+    /// @brief Indexable handle over the elements, never invalidated.
+    class view
+    {
+    public:
+        inline auto operator[](size_type pos) const -> T&
+        {
+            return s_block[pos % block_size];
+        }
+    };
+
+    // Element access
+
+    inline auto operator[](size_type pos) -> T&
+    {
+        assert(pos < m_size && "Position is out of range");
+        return s_block[pos % block_size];
+    }
+
+    inline auto operator[](size_type pos) const -> const T&
+    {
+        assert(pos < m_size && "Position is out of range");
+        return s_block[pos % block_size];
+    }
+
+    auto back() -> T&
+    {
+        assert(m_size > 0 && "Container is empty");
+        return (*this)[m_size - 1];
+    }
+
+    auto get_view() const noexcept -> view
+    {
+        return view();
+    }
+
+    /// @brief Number of elements addressable contiguously from pos on, at most up to the end of the shared block.
+    auto contiguous(size_type pos) const noexcept -> size_type
+    {
+        return std::min(m_size - pos, block_size - pos % block_size);
+    }
+
+    // Capacity
+
+    auto empty() const noexcept -> bool
+    {
+        return m_size == 0;
+    }
+
+    auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    auto capacity() const noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max();
+    }
+
+    /// @brief Nothing lives on the heap.
+    auto memory_usage() const noexcept -> size_type
+    {
+        return 0;
+    }
+
+    auto reserve(size_type) noexcept -> void
+    {
+    }
+
+    auto shrink_to_fit() noexcept -> void
+    {
+    }
+
+    // Modifiers
+
+    auto clear() noexcept -> void
+    {
+        m_size = 0;
+    }
+
+    auto push_back(const T&) noexcept -> void
+    {
+        m_size++;
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&...) noexcept -> void
+    {
+        m_size++;
+    }
+
+    auto pop_back() noexcept -> void
+    {
+        assert(m_size > 0 && "Container is empty");
+        m_size--;
+    }
+
+    auto resize(size_type count) noexcept -> void
+    {
+        m_size = count;
+    }
+
+private:
+    static inline T s_block[block_size] = {};
+
+    size_type m_size = 0;
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "FECS/Core/TypeId.h"
+
+/**
+ * @brief Maps component TypeIds to dense indices, which pools, signatures and tables are indexed by.
+ *
+ * A type gets the next index on first use, or in the order of an explicit
+ * Register<Ts...>() call made before. The index of a type is cached in an
+ * atomic per type, so GetIndex() is a single load once assigned and first
+ * uses from several threads are safe. Indices are per process, use the
+ * TypeId to refer to a component across processes.
+ */
+class ComponentIndex
+{
+public:
+    static constexpr std::uint32_t UNASSIGNED = std::numeric_limits<std::uint32_t>::max();
+
+    template <typename T>
+    static auto GetIndex() -> std::uint32_t
+    {
+        std::uint32_t idx = s_Index<T>.load(std::memory_order_acquire);
+        return idx != UNASSIGNED ? idx : Assign<T>();
+    }
+
+    /**
+     * @brief Assigns indices to Ts in order, types already known keep theirs.
+     *
+     * Registering every component up front, before anything else uses them,
+     * makes the indices the same in every run.
+     */
+    template <typename... Ts>
+    static auto Register() -> void
+    {
+        (GetIndex<Ts>(), ...);
+    }
+
+    /// @brief Index of the type with the given id, UNASSIGNED if it wasn't used or registered yet.
+    static auto Find(FECS::TypeId id) -> std::uint32_t
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.indices.find(id);
+        return it != registry.indices.end() ? it->second : UNASSIGNED;
+    }
+
+    /// @brief TypeId of the type with the given index.
+    static auto IdOf(std::uint32_t idx) -> FECS::TypeId
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        assert(idx < registry.types.size() && "Component index isn't assigned");
+        return registry.types[idx].id;
+    }
+
+    /// @brief Name of the type with the given index, see FECS::TypeInfo.
+    static auto NameOf(std::uint32_t idx) -> std::string_view
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        assert(idx < registry.types.size() && "Component index isn't assigned");
+        return registry.types[idx].name;
+    }
+
+private:
+    struct Entry
+    {
+        FECS::TypeId id;
+        std::string_view name;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::unordered_map<FECS::TypeId, std::uint32_t> indices;
+        std::vector<Entry> types; ///< Indexed by component index
+    };
+
+    /// @brief Built on first use, so types can be assigned during static initialization too.
+    static auto GetRegistry() -> Registry&
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    template <typename T>
+    static auto Assign() -> std::uint32_t
+    {
+        using Type = std::remove_cv_t<T>;
+        std::uint32_t idx = Assign(FECS::TYPE_ID<Type>, FECS::TypeInfo<Type>::name);
+        s_Index<T>.store(idx, std::memory_order_release);
+        return idx;
+    }
+
+    static auto Assign(FECS::TypeId id, std::string_view name) -> std::uint32_t
+    {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto [it, inserted] = registry.indices.try_emplace(id, static_cast<std::uint32_t>(registry.types.size()));
+        if (inserted)
+        {
+            registry.types.push_back({id, name});
+        }
+        assert(registry.types[it->second].name == name && "Two component types hash to the same TypeId, specialize FECS::TypeInfo for one");
+        return it->second;
+    }
+
+    template <typename T>
+    static inline std::atomic<std::uint32_t> s_Index = UNASSIGNED;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include "FECS/Core/Types.h"
+
+namespace FECS
+{
+    /// @brief Storage layouts a component type can opt into.
+    enum class StorageKind
+    {
+        DENSE, ///< One SparseSet per type, cheapest Attach/Detach
+        TABLE, ///< Archetype tables, entities with the same table components are stored row by row
+        PAGED, ///< One SparseSet per type whose components live in fixed-size blocks, their addresses stay valid until removal
+        SOA    ///< One SparseSet per type storing every field of ComponentTraits::fields in its own array, accessed through SoARef
+    };
+
+    /// @brief Size of a cache line, a common value for ComponentTraits::alignment.
+    inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    /// @brief Defaults used by every component without a ComponentTraits specialization.
+    struct DefaultComponentTraits
+    {
+        static constexpr StorageKind storage = StorageKind::DENSE;
+
+        /// @brief Stamps added/changed ticks per component, required by the Added<T> and Changed<T> filters.
+        static constexpr bool trackChanges = false;
+
+        /// @brief Entity indices per sparse page, rare components can use smaller pages.
+        static constexpr std::size_t sparsePageSize = SPARSE_PAGE_SIZE;
+
+        /// @brief Alignment of the dense component array (e.g. CACHE_LINE_SIZE or a SIMD width), 0 keeps alignof(T).
+        static constexpr std::size_t alignment = 0;
+
+        /// @brief Factor the dense array grows by when full, unused by PAGED pools.
+        static constexpr std::size_t growth = 2;
+
+        /// @brief Bytes per block of a PAGED pool.
+        static constexpr std::size_t pagedBlockSize = PAGED_BLOCK_SIZE;
+
+        /// @brief Keeps one presence bit per entity index, answering Has() and query joins without the sparse pages.
+        static constexpr bool presenceBitmap = true;
+    };
+
+    /**
+     * @brief Compile-time storage configuration of a component type.
+     *
+     * Specialize it, deriving from DefaultComponentTraits, to change the layout:
+     * @code
+     * template <>
+     * struct FECS::ComponentTraits<Position> : FECS::DefaultComponentTraits
+     * {
+     *     static constexpr FECS::StorageKind storage = FECS::StorageKind::TABLE;
+     * };
+     * @endcode
+     *
+     * Sparse set pools also read their sparse page size, dense alignment and
+     * growth policy from here:
+     * @code
+     * template <>
+     * struct FECS::ComponentTraits<Boss> : FECS::DefaultComponentTraits
+     * {
+     *     static constexpr std::size_t sparsePageSize = 64;
+     *     static constexpr std::size_t alignment = FECS::CACHE_LINE_SIZE;
+     * };
+     * @endcode
+     *
+     * SoA components list every data member as a field:
+     * @code
+     * template <>
+     * struct FECS::ComponentTraits<Velocity> : FECS::DefaultComponentTraits
+     * {
+     *     static constexpr FECS::StorageKind storage = FECS::StorageKind::SOA;
+     *     static constexpr auto fields = std::make_tuple(&Velocity::x, &Velocity::y);
+     * };
+     * @endcode
+     *
+     * Setting trackChanges lets queries filter on Added<T> and Changed<T>:
+     * @code
+     * template <>
+     * struct FECS::ComponentTraits<Health> : FECS::DefaultComponentTraits
+     * {
+     *     static constexpr bool trackChanges = true;
+     * };
+     * @endcode
+     */
+    template <typename T>
+    struct ComponentTraits : DefaultComponentTraits
+    {
+    };
+
+    /// @brief Whether T (ignoring const) is stored in archetype tables.
+    template <typename T>
+    inline constexpr bool IS_TABLE_COMPONENT = ComponentTraits<std::remove_cvref_t<T>>::storage == StorageKind::TABLE;
+
+    /// @brief Whether T (ignoring const) stores its fields in separate arrays.
+    template <typename T>
+    inline constexpr bool IS_SOA_COMPONENT = ComponentTraits<std::remove_cvref_t<T>>::storage == StorageKind::SOA;
+
+    /**
+     * @brief Whether T (ignoring const) is a pooled trivial empty type.
+     *
+     * Tag pools only keep their entity list and sparse index, every tag
+     * reference aliases one shared instance. Empty types with user-provided
+     * constructors or destructors keep a regular dense array, so those run.
+     */
+    template <typename T>
+    inline constexpr bool IS_TAG_COMPONENT = !IS_TABLE_COMPONENT<T> && std::is_empty_v<std::remove_cvref_t<T>> && std::is_trivial_v<std::remove_cvref_t<T>>;
+
+    /// @brief Whether handing out C stamps it as changed, true for mutable access to tracked pools.
+    template <typename C>
+    inline constexpr bool MARKS_CHANGES = !IS_TABLE_COMPONENT<C> && !IS_TAG_COMPONENT<C> && !std::is_const_v<std::remove_reference_t<C>> && ComponentTraits<std::remove_cvref_t<C>>::trackChanges;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+namespace FECS
+{
+    /**
+     * @brief Query term matching entities that have none of Ts.
+     *
+     * Nothing is passed to the callback for it.
+     */
+    template <typename... Ts>
+    struct Without
+    {
+    };
+
+    /**
+     * @brief Query term passing a pointer to T, nullptr if the entity doesn't have one.
+     *
+     * Optional terms don't restrict the match.
+     */
+    template <typename T>
+    struct Optional
+    {
+    };
+
+    /**
+     * @brief Query term matching entities that have at least one of Ts.
+     *
+     * Nothing is passed to the callback for it.
+     */
+    template <typename... Ts>
+    struct AnyOf
+    {
+    };
+
+    /**
+     * @brief Query term matching entities whose T was attached since the system last ran.
+     *
+     * T must opt in with ComponentTraits::trackChanges. Nothing is passed to the callback for it.
+     */
+    template <typename T>
+    struct Added
+    {
+    };
+
+    /**
+     * @brief Query term matching entities whose T was attached or mutably accessed since the system last ran.
+     *
+     * Mutable query access counts as a change, whether or not the value was
+     * written. T must opt in with ComponentTraits::trackChanges.
+     */
+    template <typename T>
+    struct Changed
+    {
+    };
+}
@@ -0,0 +1,43 @@
+/**
+ * @file Reduce.h
+ * @brief Combine operations for parallel reductions over queries.
+ *
+ * Each operation merges two partial results. They are used per chunk by
+ * QueryBuilder::ParallelReduce and then once more across chunk results.
+ */
+
+#pragma once
+#include <algorithm>
+
+namespace FECS::Reduce
+{
+    /// @brief Adds partial results together.
+    struct Sum
+    {
+        template <typename T>
+        auto operator()(const T& a, const T& b) const -> T
+        {
+            return a + b;
+        }
+    };
+
+    /// @brief Keeps the smallest partial result.
+    struct Min
+    {
+        template <typename T>
+        auto operator()(const T& a, const T& b) const -> T
+        {
+            return std::min(a, b);
+        }
+    };
+
+    /// @brief Keeps the largest partial result.
+    struct Max
+    {
+        template <typename T>
+        auto operator()(const T& a, const T& b) const -> T
+        {
+            return std::max(a, b);
+        }
+    };
+}
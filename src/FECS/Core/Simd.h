@@ -0,0 +1,39 @@
+/**
+ * @file Simd.h
+ * @brief Compile-time selection of the vectorized code paths, and prefetch hints.
+ *
+ * The AVX2 paths are compiled in when the translation unit targets AVX2
+ * (e.g. -mavx2, /arch:AVX2 or the FECS_ENABLE_AVX2 CMake option). Defining
+ * FECS_DISABLE_SIMD keeps the portable scalar paths only.
+ */
+
+#pragma once
+
+#if defined(__AVX2__) && !defined(FECS_DISABLE_SIMD)
+#define FECS_SIMD_AVX2 1
+#include <immintrin.h>
+#else
+#define FECS_SIMD_AVX2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace FECS
+{
+    /// @brief Whether the AVX2 code paths are compiled in.
+    inline constexpr bool SIMD_AVX2 = FECS_SIMD_AVX2;
+
+    /// @brief Hints the cache line holding address into the cache ahead of a read or write.
+    inline auto Prefetch(const void* address) -> void
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#elif defined(_M_X64) || defined(_M_IX86)
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        (void) address;
+#endif
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "FECS/Containers/soa_vector.h"
+#include "FECS/Core/ComponentTraits.h"
+
+namespace FECS
+{
+    /// @brief Minimum alignment of the field arrays of a SoA pool, enough for aligned loads of any SIMD width.
+    inline constexpr std::size_t SOA_FIELD_ALIGNMENT = CACHE_LINE_SIZE;
+
+    namespace Internal
+    {
+        template <typename T, typename Sequence>
+        struct SoAVectorOf;
+
+        template <typename T, std::size_t... I>
+        struct SoAVectorOf<T, std::index_sequence<I...>>
+        {
+            using Type = soa_vector<T, std::max(ComponentTraits<T>::alignment, SOA_FIELD_ALIGNMENT), std::get<I>(ComponentTraits<T>::fields)...>;
+        };
+
+        template <typename T, bool SOA = IS_SOA_COMPONENT<T>>
+        struct AccessOf
+        {
+            using Reference = T&;
+            using Pointer = T*;
+        };
+
+        template <typename T>
+        struct AccessOf<T, true>;
+    }
+
+    /// @brief Dense storage of a SoA component, one array per entry of ComponentTraits<T>::fields.
+    template <typename T>
+    using SoAVector = typename Internal::SoAVectorOf<T, std::make_index_sequence<std::tuple_size_v<std::remove_const_t<decltype(ComponentTraits<T>::fields)>>>>::Type;
+
+    /**
+     * @brief Proxy reference to a SoA component, const when T is.
+     *
+     * Fields are reached with ref.get<&T::field>(), the whole component is
+     * gathered by converting to T and scattered by assigning a T.
+     */
+    template <typename T>
+    using SoARef = typename SoAVector<std::remove_const_t<T>>::template basic_reference<std::is_const_v<T>>;
+
+    /// @brief Proxy pointer to SoA components, ptr.get<&T::field>() is the array of one field.
+    template <typename T>
+    using SoAPtr = typename SoAVector<std::remove_const_t<T>>::template basic_pointer<std::is_const_v<T>>;
+
+    namespace Internal
+    {
+        template <typename T>
+        struct AccessOf<T, true>
+        {
+            using Reference = SoARef<T>;
+            using Pointer = SoAPtr<T>;
+        };
+    }
+
+    /// @brief What accessing a pooled T hands out, T& or a SoARef<T> for SoA components.
+    template <typename T>
+    using ComponentRef = typename Internal::AccessOf<T>::Reference;
+
+    /// @brief What chunked iteration hands out for a pooled T, T* or a SoAPtr<T> for SoA components.
+    template <typename T>
+    using ComponentPtr = typename Internal::AccessOf<T>::Pointer;
+}
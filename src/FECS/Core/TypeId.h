@@ -0,0 +1,83 @@
+/**
+ * @file TypeId.h
+ * @brief Compile-time type identifiers, hashed from the type's name.
+ *
+ * Unlike indices handed out on first use, a TypeId doesn't depend on call
+ * order, so it is the same in every run and every module built by the same
+ * compiler. Snapshots and replication can refer to components by it.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace FECS
+{
+    /// @brief Identifier of a type, the 64-bit FNV-1a hash of its name, see TypeInfo.
+    using TypeId = std::uint64_t;
+
+    /// @brief 64-bit FNV-1a hash of a string.
+    constexpr auto HashTypeName(std::string_view name) -> TypeId
+    {
+        TypeId hash = 14695981039346656037ull;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    namespace Internal
+    {
+        template <typename T>
+        constexpr auto DecoratedTypeName() -> std::string_view
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+
+        // The decoration around the name of int is the same for every type
+        inline constexpr std::string_view DECORATED_INT = DecoratedTypeName<int>();
+        inline constexpr std::size_t TYPE_NAME_PREFIX = DECORATED_INT.rfind("int");
+        inline constexpr std::size_t TYPE_NAME_SUFFIX = DECORATED_INT.size() - TYPE_NAME_PREFIX - 3;
+
+        /// @brief The compiler's spelling of T, e.g. "Position" or "struct Position" with MSVC.
+        template <typename T>
+        constexpr auto TypeNameOf() -> std::string_view
+        {
+            std::string_view name = DecoratedTypeName<T>();
+            return name.substr(TYPE_NAME_PREFIX, name.size() - TYPE_NAME_PREFIX - TYPE_NAME_SUFFIX);
+        }
+    }
+
+    /**
+     * @brief Name and TypeId of T.
+     *
+     * Specialize it to pin the identifier of a type across compilers, whose
+     * spellings of the same type may differ:
+     * @code
+     * template <>
+     * struct FECS::TypeInfo<Position>
+     * {
+     *     static constexpr std::string_view name = "Position";
+     *     static constexpr FECS::TypeId id = FECS::HashTypeName(name);
+     * };
+     * @endcode
+     */
+    template <typename T>
+    struct TypeInfo
+    {
+        static constexpr std::string_view name = Internal::TypeNameOf<T>();
+        static constexpr TypeId id = HashTypeName(name);
+    };
+
+    /// @brief TypeId of T, const and volatile are ignored.
+    template <typename T>
+    inline constexpr TypeId TYPE_ID = TypeInfo<std::remove_cv_t<T>>::id;
+}
@@ -7,15 +7,32 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <cstdint>
 #include <cstddef>
 #include <limits>
+#include <type_traits>
 
 /// @brief Defines the default number of elements per sparse page, if not specified
 #ifndef FECS_SPARSE_PAGE_SIZE
 #define FECS_SPARSE_PAGE_SIZE 2048
 #endif
 
+/// @brief Switches entity handles to 64 bits (32-bit index, 32-bit version), see FECS::EntityTraits
+#ifndef FECS_64BIT_ENTITIES
+#define FECS_64BIT_ENTITIES 0
+#endif
+
+/// @brief Defines the size in bytes of one archetype table chunk, if not specified
+#ifndef FECS_TABLE_CHUNK_SIZE
+#define FECS_TABLE_CHUNK_SIZE 16384
+#endif
+
+/// @brief Defines the size in bytes of one block of a paged component pool, if not specified
+#ifndef FECS_PAGED_BLOCK_SIZE
+#define FECS_PAGED_BLOCK_SIZE 16384
+#endif
+
 namespace FECS
 {
     /**
@@ -25,8 +42,74 @@ namespace FECS
     {
     };
 
-    /// @brief Type alias for entity IDs (32-bit unsigned integer)
-    using Entity = std::uint32_t;
+    /**
+     * @brief Encoding of entity handles: an integer holding an index and a version.
+     *
+     * The index addresses the slot of the entity, the version is bumped when
+     * the slot is recycled so stale handles can be told apart. Both fit into
+     * 32 bits in every policy, NPOS is never a valid index.
+     *
+     * @tparam T Integer type of a handle.
+     * @tparam IndexBits Low bits of a handle holding the index, the rest holds the version.
+     */
+    template <typename T, std::uint32_t IndexBits>
+    struct BasicEntityTraits
+    {
+        static_assert(std::is_unsigned_v<T>, "Entity handles are unsigned integers");
+        static_assert(IndexBits > 0 && IndexBits < sizeof(T) * 8, "Handles need index and version bits");
+        static_assert(IndexBits <= 32 && sizeof(T) * 8 - IndexBits <= 32, "Index and version have to fit into 32 bits each");
+
+        using Type = T;
+
+        /// @brief Number of bits used to store the entity index.
+        static constexpr std::uint32_t INDEX_BITS = IndexBits;
+
+        /// @brief Number of bits used to store the entity version.
+        static constexpr std::uint32_t VERSION_BITS = sizeof(T) * 8 - IndexBits;
+
+        /// @brief Bitmask to extract the entity index portion.
+        static constexpr T INDEX_MASK = (T(1) << IndexBits) - 1;
+
+        /// @brief Bitmask to extract the entity version portion.
+        static constexpr T VERSION_MASK = ~INDEX_MASK;
+
+        /// @brief Highest index an entity can have, the all ones index is reserved as a null link.
+        static constexpr std::uint32_t MAX_INDEX = static_cast<std::uint32_t>(std::min<T>(INDEX_MASK, std::numeric_limits<std::uint32_t>::max()) - 1);
+
+        /// @brief Highest version, versions wrap around to 0 past it.
+        static constexpr std::uint32_t MAX_VERSION = static_cast<std::uint32_t>(VERSION_MASK >> IndexBits);
+
+        static constexpr auto Build(std::uint32_t index, std::uint32_t version) -> T
+        {
+            return (T(version) << IndexBits) | (T(index) & INDEX_MASK);
+        }
+
+        static constexpr auto Index(T e) -> std::uint32_t
+        {
+            return static_cast<std::uint32_t>(e & INDEX_MASK);
+        }
+
+        static constexpr auto Version(T e) -> std::uint32_t
+        {
+            return static_cast<std::uint32_t>((e & VERSION_MASK) >> IndexBits);
+        }
+    };
+
+    /// @brief 32-bit handles, about a million entity slots and 4096 versions per slot.
+    using EntityTraits32 = BasicEntityTraits<std::uint32_t, 20>;
+
+    /// @brief 64-bit handles with a 32-bit index and a 32-bit version.
+    using EntityTraits64 = BasicEntityTraits<std::uint64_t, 32>;
+
+    /// @brief The entity encoding of the build, see FECS_64BIT_ENTITIES.
+#if FECS_64BIT_ENTITIES
+    using EntityTraits = EntityTraits64;
+#else
+    using EntityTraits = EntityTraits32;
+#endif
+
+    /// @brief Type alias for entity IDs, 32 or 64-bit depending on EntityTraits.
+    using Entity = EntityTraits::Type;
 
     /// @brief Type alias for identifying component type indices.
     using ComponentIndex = std::uint32_t;
@@ -37,33 +120,63 @@ namespace FECS
     /// @brief Defines the number of entities per sparse set page.
     static constexpr size_t SPARSE_PAGE_SIZE = FECS_SPARSE_PAGE_SIZE;
 
-    /// @brief Number of bits used to store the entity index (lower 20 bits).
-    static constexpr std::uint32_t INDEX_BITS = 20;
+    /// @brief Defines the number of bytes per archetype table chunk.
+    static constexpr size_t TABLE_CHUNK_SIZE = FECS_TABLE_CHUNK_SIZE;
+
+    /// @brief Defines the number of bytes per block of a paged component pool.
+    static constexpr size_t PAGED_BLOCK_SIZE = FECS_PAGED_BLOCK_SIZE;
+
+    /// @brief Number of bits used to store the entity index.
+    static constexpr std::uint32_t INDEX_BITS = EntityTraits::INDEX_BITS;
 
-    /// @brief Number of bits used to store the entity version (upper 12 bits).
-    static constexpr std::uint32_t VERSION_BITS = 12;
+    /// @brief Number of bits used to store the entity version.
+    static constexpr std::uint32_t VERSION_BITS = EntityTraits::VERSION_BITS;
 
     /// @brief Bitmask to extract the entity index portion.
-    static constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr Entity INDEX_MASK = EntityTraits::INDEX_MASK;
 
     /// @brief Bitmask to extract the entity version portion.
-    static constexpr std::uint32_t VERSION_MASK = ~INDEX_MASK;
+    static constexpr Entity VERSION_MASK = EntityTraits::VERSION_MASK;
 
     /// @brief Special constant used to indicate a "not found" index.
     static constexpr std::uint32_t NPOS = std::numeric_limits<std::uint32_t>::max();
 
+    /// @brief Type alias for change detection ticks, advanced once per system run.
+    using Tick = std::uint32_t;
+
+    /**
+     * @brief Window of a change detection check.
+     *
+     * Changes stamped after lastRun are visible, changes made through the
+     * window are stamped with thisRun.
+     */
+    struct TickRange
+    {
+        Tick lastRun = 0;
+        Tick thisRun = 0;
+    };
+
+    /**
+     * @brief Compares ticks so that wrapping around stays correct for 2^31 ticks.
+     * @return Whether tick happened after since.
+     */
+    inline auto IsNewerTick(Tick tick, Tick since) -> bool
+    {
+        return static_cast<std::int32_t>(tick - since) > 0;
+    }
+
     /**
-     * @brief Combines an entity index and version into a single 32-bit entity ID.
+     * @brief Combines an entity index and version into a single entity ID.
      *
-     * The lower 20 bits are used for the index, and the upper 12 for the version.
+     * The lower INDEX_BITS are used for the index, the upper ones for the version.
      *
      * @param index The entity index.
      * @param version The entity verison.
-     * @return A composed 32-bit entity ID.
+     * @return A composed entity ID.
      */
     inline auto BuildEntityIndex(std::uint32_t index, std::uint32_t version) -> Entity
     {
-        return (version << INDEX_BITS) | (index & INDEX_MASK);
+        return EntityTraits::Build(index, version);
     }
 
     /**
@@ -73,7 +186,7 @@ namespace FECS
      */
     inline auto GetEntityIndex(Entity e) -> std::uint32_t
     {
-        return e & INDEX_MASK;
+        return EntityTraits::Index(e);
     }
 
     /**
@@ -83,6 +196,6 @@ namespace FECS
      */
     inline auto GetEntityVersion(Entity e) -> std::uint32_t
     {
-        return (e & VERSION_MASK) >> INDEX_BITS;
+        return EntityTraits::Version(e);
     }
 }
@@ -1,17 +1,36 @@
 #pragma once
 #include "FECS/World.h"
 #include "FECS/Manager/ScheduleManager.h"
+#include "FECS/Manager/CommandManager.h"
 #include "FECS/Manager/ComponentManager.h"
 #include "FECS/Manager/EntityManager.h"
+#include "FECS/Manager/JobManager.h"
 #include "FECS/Manager/ResourceManager.h"
 #include "FECS/Manager/ViewManager.h"
+#include "FECS/Builder/CachedQuery.h"
 #include "FECS/Builder/EntityBuilder.h"
+#include "FECS/Builder/GroupBuilder.h"
 #include "FECS/Builder/QueryBuilder.h"
 #include "FECS/Builder/SystemBuilder.h"
+#include "FECS/Core/QueryFilters.h"
+#include "FECS/Core/Reduce.h"
+#include "FECS/Core/SoA.h"
 
 namespace FECS
 {
     template <typename... T>
     using Query = FECS::Builder::QueryBuilder<T...>;
+    template <typename... T>
+    using CachedQuery = FECS::Builder::CachedQuery<T...>;
+    template <typename... T>
+    using Group = FECS::Builder::GroupBuilder<T...>;
     using EntityBuilder = FECS::Builder::EntityBuilder;
+    using ExecutionMode = FECS::Internal::ExecutionMode;
+    using JobManager = FECS::Manager::JobManager;
+    using JobHandle = FECS::Manager::JobHandle;
+    using Commands = FECS::Manager::SystemCommands;
+    template <typename T>
+    using Pool = FECS::Container::PoolHandle<T>;
+    template <typename T>
+    using Lookup = FECS::Container::PoolHandle<T, false>;
 }
@@ -0,0 +1,611 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include "FECS/Containers/ArchetypeStorage.h"
+#include "FECS/Containers/ComponentStorage.h"
+#include "FECS/Containers/PresenceBitmap.h"
+#include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/ComponentIndex.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/QueryFilters.h"
+#include "FECS/Core/SoA.h"
+#include "FECS/Core/Types.h"
+
+namespace FECS::Internal
+{
+    /// @brief Storage a component is reached through, its pool or the archetype tables.
+    template <typename C>
+    using StorageOf = std::conditional_t<IS_TABLE_COMPONENT<C>, Container::ArchetypeStorage, Container::SparseSet<std::remove_const_t<C>>>;
+
+    template <typename C>
+    inline auto FindStorage(Container::ComponentStorage& storage) -> StorageOf<C>*
+    {
+        if constexpr (IS_TABLE_COMPONENT<C>)
+        {
+            return &storage.GetArchetypes();
+        }
+        else
+        {
+            return storage.template GetPool<std::remove_const_t<C>>();
+        }
+    }
+
+    template <typename C>
+    inline auto HasComponent(StorageOf<C>* storage, Entity e) -> bool
+    {
+        if constexpr (IS_TABLE_COMPONENT<C>)
+        {
+            return storage->template Has<std::remove_const_t<C>>(e);
+        }
+        else
+        {
+            return storage->Has(e);
+        }
+    }
+
+    /// @brief Whether C lives in a pool keeping a presence bitmap.
+    template <typename C>
+    inline constexpr bool HAS_PRESENCE = !IS_TABLE_COMPONENT<C> && ComponentTraits<std::remove_cvref_t<C>>::presenceBitmap;
+
+    using PresenceWord = Container::PresenceBitmap::Word;
+
+    /// @brief Every index of a word, the mask of terms that can't reject by presence.
+    inline constexpr PresenceWord ALL_PRESENT = ~PresenceWord(0);
+
+    /// @brief The presence bits of the pool of C, none when C has no bitmap.
+    template <typename C>
+    inline auto PresenceOf(StorageOf<C>* storage, std::size_t word) -> PresenceWord
+    {
+        if constexpr (HAS_PRESENCE<C>)
+        {
+            return storage->GetPresence().GetWord(word);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    template <typename C>
+    inline auto ComponentId() -> std::uint32_t
+    {
+        return ::ComponentIndex::GetIndex<std::remove_const_t<C>>();
+    }
+
+    /// @brief Declares C as read when const, written otherwise.
+    template <typename C, typename Access>
+    inline auto DeclareAccess(Container::ComponentStorage& storage, Access& access) -> void
+    {
+        storage.template Prepare<std::remove_const_t<C>>();
+        if constexpr (std::is_const_v<C>)
+        {
+            access.componentReads.push_back(ComponentId<C>());
+        }
+        else
+        {
+            access.componentWrites.push_back(ComponentId<C>());
+        }
+    }
+
+    /**
+     * @brief One template argument of a QueryBuilder, resolved against its storage.
+     *
+     * Every term can accept or reject a whole table up front (AcceptTable, which
+     * also yields a per-table column value), then accepts rows of that table
+     * (AcceptRow) or, when the query is driven by a pool, single entities
+     * (AcceptEntity). Passed terms produce the callback argument through
+     * FetchRow or FetchEntity.
+     *
+     * MASKED terms can also reject 64 entity indices at once: Mask(word) clears
+     * the bits of indices AcceptEntity would reject for sure, QueryBuilder ANDs
+     * the masks of all terms before looking at single entities.
+     *
+     * The primary template is a required component, handed out as a reference
+     * (a SoARef<C> proxy for SoA components).
+     */
+    template <typename C>
+    struct QueryTerm
+    {
+        using Argument = std::conditional_t<IS_TABLE_COMPONENT<C>, C&, ComponentRef<C>>;
+
+        static constexpr bool PASSED = true;
+        static constexpr bool REQUIRED = true;
+        static constexpr bool PLAIN = true;
+        static constexpr bool IN_TABLE = IS_TABLE_COMPONENT<C>;
+        static constexpr bool MASKED = HAS_PRESENCE<C>;
+
+        QueryTerm(Container::ComponentStorage& components, TickRange ticks)
+            : storage(FindStorage<C>(components)),
+              ticks(ticks)
+        {
+        }
+
+        template <typename Access>
+        static auto Declare(Container::ComponentStorage& components, Access& access) -> void
+        {
+            DeclareAccess<C>(components, access);
+        }
+
+        inline auto Mask(std::size_t word) const -> PresenceWord
+        {
+            return MASKED ? PresenceOf<C>(storage, word) : ALL_PRESENT;
+        }
+
+        /// @brief Words past which the mask is zero.
+        inline auto MaskWords() const -> std::size_t
+        {
+            if constexpr (MASKED)
+            {
+                return storage->GetPresence().WordCount();
+            }
+            else
+            {
+                return std::numeric_limits<std::size_t>::max();
+            }
+        }
+
+        auto Lock() const -> void
+        {
+            storage->Lock();
+        }
+
+        auto Unlock() const -> void
+        {
+            storage->Unlock();
+        }
+
+        auto AcceptTable(const Container::ArchetypeTable& table, std::uint32_t& column) const -> bool
+        {
+            if constexpr (IN_TABLE)
+            {
+                column = table.ColumnOf(ComponentId<C>());
+                return column != NPOS;
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        auto ColumnData(Container::ArchetypeTable& table, std::size_t chunk, std::uint32_t column) const -> void*
+        {
+            if constexpr (IN_TABLE)
+            {
+                return table.ColumnData(chunk, column);
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        inline auto AcceptRow(Entity e, std::uint32_t) const -> bool
+        {
+            if constexpr (IN_TABLE)
+            {
+                return true;
+            }
+            else
+            {
+                return storage->Has(e);
+            }
+        }
+
+        inline auto AcceptEntity(Entity e) const -> bool
+        {
+            return HasComponent<C>(storage, e);
+        }
+
+        inline auto FetchRow(Entity e, void* data, std::uint32_t row) const -> Argument
+        {
+            if constexpr (IN_TABLE)
+            {
+                return static_cast<C*>(data)[row];
+            }
+            else
+            {
+                return FetchEntity(e);
+            }
+        }
+
+        inline auto FetchEntity(Entity e) const -> Argument
+        {
+            if constexpr (IN_TABLE)
+            {
+                return storage->template Get<std::remove_const_t<C>>(e);
+            }
+            else if constexpr (MARKS_CHANGES<C>)
+            {
+                return FetchDense(storage->DenseIndex(e));
+            }
+            else
+            {
+                return static_cast<Argument>(storage->Get(e));
+            }
+        }
+
+        /// @brief Dense indices of a block of entities, pooled components only, see QueryBuilder's batched join.
+        inline auto Resolve(const Entity* entities, std::size_t count, std::uint32_t* slots) const -> void
+        {
+            storage->DenseIndices(entities, count, slots);
+        }
+
+        inline auto Prefetch(std::uint32_t dense) const -> void
+        {
+            storage->PrefetchDense(dense);
+        }
+
+        /// @brief The component at a dense index found by Resolve, pooled components only.
+        inline auto FetchDense(std::uint32_t dense) const -> Argument
+        {
+            if constexpr (MARKS_CHANGES<C>)
+            {
+                storage->MarkChanged(dense, ticks.thisRun);
+            }
+            return static_cast<Argument>(storage->GetDataVector()[dense]);
+        }
+
+        StorageOf<C>* storage;
+        TickRange ticks;
+    };
+
+    template <typename C>
+    struct QueryTerm<Optional<C>>
+    {
+        static_assert(!IS_SOA_COMPONENT<C>, "Optional<T> can't hand out a SoA component, query it with T and Without<T> separately");
+
+        using Argument = C*;
+
+        static constexpr bool PASSED = true;
+        static constexpr bool REQUIRED = false;
+        static constexpr bool PLAIN = false;
+        static constexpr bool IN_TABLE = IS_TABLE_COMPONENT<C>;
+        static constexpr bool MASKED = false;
+
+        QueryTerm(Container::ComponentStorage& components, TickRange ticks)
+            : storage(FindStorage<C>(components)),
+              ticks(ticks)
+        {
+        }
+
+        template <typename Access>
+        static auto Declare(Container::ComponentStorage& components, Access& access) -> void
+        {
+            DeclareAccess<C>(components, access);
+        }
+
+        inline auto Mask(std::size_t) const -> PresenceWord
+        {
+            return ALL_PRESENT;
+        }
+
+        auto Lock() const -> void
+        {
+            storage->Lock();
+        }
+
+        auto Unlock() const -> void
+        {
+            storage->Unlock();
+        }
+
+        auto AcceptTable(const Container::ArchetypeTable& table, std::uint32_t& column) const -> bool
+        {
+            if constexpr (IN_TABLE)
+            {
+                column = table.ColumnOf(ComponentId<C>());
+            }
+            return true;
+        }
+
+        auto ColumnData(Container::ArchetypeTable& table, std::size_t chunk, std::uint32_t column) const -> void*
+        {
+            if constexpr (IN_TABLE)
+            {
+                return column != NPOS ? table.ColumnData(chunk, column) : nullptr;
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        inline auto AcceptRow(Entity, std::uint32_t) const -> bool
+        {
+            return true;
+        }
+
+        inline auto AcceptEntity(Entity) const -> bool
+        {
+            return true;
+        }
+
+        inline auto FetchRow(Entity e, void* data, std::uint32_t row) const -> Argument
+        {
+            if constexpr (IN_TABLE)
+            {
+                return data ? static_cast<C*>(data) + row : nullptr;
+            }
+            else
+            {
+                return FetchEntity(e);
+            }
+        }
+
+        inline auto FetchEntity(Entity e) const -> Argument
+        {
+            if constexpr (IN_TABLE)
+            {
+                return storage->template Has<std::remove_const_t<C>>(e) ? &storage->template Get<std::remove_const_t<C>>(e) : nullptr;
+            }
+            else
+            {
+                // A single sparse lookup for both the test and the access
+                std::uint32_t dense = storage->DenseIndex(e);
+                if (dense == NPOS)
+                {
+                    return nullptr;
+                }
+
+                if constexpr (MARKS_CHANGES<C>)
+                {
+                    storage->MarkChanged(dense, ticks.thisRun);
+                }
+                return static_cast<C*>(&storage->GetDataVector()[dense]);
+            }
+        }
+
+        StorageOf<C>* storage;
+        TickRange ticks;
+    };
+
+    /**
+     * @brief Shared part of the filter terms, which test presence only and pass nothing.
+     */
+    template <typename... Ts>
+    struct FilterTerm
+    {
+        static constexpr bool PASSED = false;
+        static constexpr bool REQUIRED = false;
+        static constexpr bool PLAIN = false;
+        static constexpr bool IN_TABLE = false;
+
+        FilterTerm(Container::ComponentStorage& components, TickRange)
+            : storages(FindStorage<Ts>(components)...)
+        {
+        }
+
+        template <typename Access>
+        static auto Declare(Container::ComponentStorage& components, Access& access) -> void
+        {
+            // Only presence is tested, which never conflicts with writers of the values
+            (DeclareAccess<const Ts>(components, access), ...);
+        }
+
+        auto Lock() const -> void
+        {
+            std::apply([](auto*... storage)
+            {
+                (storage->Lock(), ...);
+            }, storages);
+        }
+
+        auto Unlock() const -> void
+        {
+            std::apply([](auto*... storage)
+            {
+                (storage->Unlock(), ...);
+            }, storages);
+        }
+
+        auto ColumnData(Container::ArchetypeTable&, std::size_t, std::uint32_t) const -> void*
+        {
+            return nullptr;
+        }
+
+        /// @brief Whether the table stores one of the table components among Ts.
+        static auto AnyInTable(const Container::ArchetypeTable& table) -> bool
+        {
+            return ((IS_TABLE_COMPONENT<Ts> && table.Has(ComponentId<Ts>())) || ...);
+        }
+
+        /// @brief Whether the entity has one of the pooled Ts, table components are skipped.
+        inline auto AnyInPools(Entity e) const -> bool
+        {
+            return AnyInPools(e, std::index_sequence_for<Ts...>{});
+        }
+
+        /// @brief Whether the entity has one of Ts, whatever their storage.
+        inline auto AnyOfAll(Entity e) const -> bool
+        {
+            return AnyOfAll(e, std::index_sequence_for<Ts...>{});
+        }
+
+        /// @brief The indices known to have one of Ts, from the pools keeping a presence bitmap.
+        inline auto AnyPresent(std::size_t word) const -> PresenceWord
+        {
+            return AnyPresent(word, std::index_sequence_for<Ts...>{});
+        }
+
+        std::tuple<StorageOf<Ts>*...> storages;
+
+    private:
+        template <std::size_t... I>
+        inline auto AnyInPools(Entity e, std::index_sequence<I...>) const -> bool
+        {
+            return (PooledHas<Ts>(std::get<I>(storages), e) || ...);
+        }
+
+        template <std::size_t... I>
+        inline auto AnyOfAll(Entity e, std::index_sequence<I...>) const -> bool
+        {
+            return (HasComponent<Ts>(std::get<I>(storages), e) || ...);
+        }
+
+        template <std::size_t... I>
+        inline auto AnyPresent(std::size_t word, std::index_sequence<I...>) const -> PresenceWord
+        {
+            return (PresenceOf<Ts>(std::get<I>(storages), word) | ...);
+        }
+
+        template <typename T>
+        static inline auto PooledHas(StorageOf<T>* storage, Entity e) -> bool
+        {
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return false;
+            }
+            else
+            {
+                return storage->Has(e);
+            }
+        }
+    };
+
+    template <typename... Ts>
+    struct QueryTerm<Without<Ts...>> : FilterTerm<Ts...>
+    {
+        using FilterTerm<Ts...>::FilterTerm;
+
+        static constexpr bool MASKED = (HAS_PRESENCE<Ts> || ...);
+
+        inline auto Mask(std::size_t word) const -> PresenceWord
+        {
+            return MASKED ? ~this->AnyPresent(word) : ALL_PRESENT;
+        }
+
+        /// @brief Tables holding an excluded component are skipped entirely.
+        auto AcceptTable(const Container::ArchetypeTable& table, std::uint32_t&) const -> bool
+        {
+            return !this->AnyInTable(table);
+        }
+
+        inline auto AcceptRow(Entity e, std::uint32_t) const -> bool
+        {
+            return !this->AnyInPools(e);
+        }
+
+        inline auto AcceptEntity(Entity e) const -> bool
+        {
+            return !this->AnyOfAll(e);
+        }
+    };
+
+    template <typename... Ts>
+    struct QueryTerm<AnyOf<Ts...>> : FilterTerm<Ts...>
+    {
+        using FilterTerm<Ts...>::FilterTerm;
+
+        /// @brief Only when every alternative has a bitmap, a missing bit proves nothing otherwise.
+        static constexpr bool MASKED = (HAS_PRESENCE<Ts> && ...);
+
+        inline auto Mask(std::size_t word) const -> PresenceWord
+        {
+            return MASKED ? this->AnyPresent(word) : ALL_PRESENT;
+        }
+
+        /// @brief The column value records whether the table alone satisfies the term.
+        auto AcceptTable(const Container::ArchetypeTable& table, std::uint32_t& column) const -> bool
+        {
+            column = this->AnyInTable(table);
+            return true;
+        }
+
+        inline auto AcceptRow(Entity e, std::uint32_t column) const -> bool
+        {
+            return column || this->AnyInPools(e);
+        }
+
+        inline auto AcceptEntity(Entity e) const -> bool
+        {
+            return this->AnyOfAll(e);
+        }
+    };
+
+    /**
+     * @brief Shared part of Added<T> and Changed<T>, comparing the per-slot ticks of T against the last run.
+     */
+    template <typename T, bool ADDED>
+    struct TickTerm
+    {
+        static_assert(!IS_TABLE_COMPONENT<T> && ComponentTraits<T>::trackChanges, "Added<T> and Changed<T> need a pooled component with ComponentTraits::trackChanges");
+
+        static constexpr bool PASSED = false;
+        static constexpr bool REQUIRED = false;
+        static constexpr bool PLAIN = false;
+        static constexpr bool IN_TABLE = false;
+        static constexpr bool MASKED = HAS_PRESENCE<T>;
+
+        TickTerm(Container::ComponentStorage& components, TickRange ticks)
+            : storage(FindStorage<T>(components)),
+              ticks(ticks)
+        {
+        }
+
+        template <typename Access>
+        static auto Declare(Container::ComponentStorage& components, Access& access) -> void
+        {
+            DeclareAccess<const T>(components, access);
+        }
+
+        auto Lock() const -> void
+        {
+            storage->Lock();
+        }
+
+        auto Unlock() const -> void
+        {
+            storage->Unlock();
+        }
+
+        auto AcceptTable(const Container::ArchetypeTable&, std::uint32_t&) const -> bool
+        {
+            return true;
+        }
+
+        auto ColumnData(Container::ArchetypeTable&, std::size_t, std::uint32_t) const -> void*
+        {
+            return nullptr;
+        }
+
+        inline auto Mask(std::size_t word) const -> PresenceWord
+        {
+            return MASKED ? PresenceOf<T>(storage, word) : ALL_PRESENT;
+        }
+
+        inline auto AcceptRow(Entity e, std::uint32_t) const -> bool
+        {
+            return AcceptEntity(e);
+        }
+
+        inline auto AcceptEntity(Entity e) const -> bool
+        {
+            std::uint32_t dense = storage->DenseIndex(e);
+            if (dense == NPOS)
+            {
+                return false;
+            }
+
+            Tick tick = ADDED ? storage->GetAddedTick(dense) : storage->GetChangedTick(dense);
+            return IsNewerTick(tick, ticks.lastRun);
+        }
+
+        StorageOf<T>* storage;
+        TickRange ticks;
+    };
+
+    template <typename T>
+    struct QueryTerm<Added<T>> : TickTerm<std::remove_const_t<T>, true>
+    {
+        using TickTerm<std::remove_const_t<T>, true>::TickTerm;
+    };
+
+    template <typename T>
+    struct QueryTerm<Changed<T>> : TickTerm<std::remove_const_t<T>, false>
+    {
+        using TickTerm<std::remove_const_t<T>, false>::TickTerm;
+    };
+}
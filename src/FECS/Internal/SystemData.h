@@ -1,5 +1,11 @@
 #pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <string>
 #include <vector>
+#include "FECS/Containers/ISparseSet.h"
+#include "FECS/Core/TypeId.h"
 #include "FECS/World.h"
 
 namespace FECS::Internal
@@ -13,6 +19,93 @@ namespace FECS::Internal
         TIMED
     };
 
+    /**
+     * @brief Controls how the scheduler dispatches the systems of a set.
+     *
+     * SEQUENTIAL runs every system on the calling thread in baked order, which
+     * is deterministic and the default. PARALLEL dispatches systems whose
+     * declared accesses don't conflict concurrently onto the worker pool.
+     */
+    enum class ExecutionMode
+    {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    /**
+     * @brief The data a system declared it touches, collected from its parameters.
+     *
+     * Component accesses are stored as component indices, resource accesses
+     * as TypeIds. Systems that take the World directly can reach anything, so
+     * they are marked exclusive.
+     */
+    struct SystemAccess
+    {
+        std::vector<std::uint32_t> componentReads;
+        std::vector<std::uint32_t> componentWrites;
+        std::vector<TypeId> resourceReads;
+        std::vector<TypeId> resourceWrites;
+        bool exclusive = false;
+
+        auto ConflictsWith(const SystemAccess& other) const -> bool
+        {
+            if (exclusive || other.exclusive)
+            {
+                return true;
+            }
+
+            return Overlaps(componentWrites, other.componentWrites) ||
+                   Overlaps(componentWrites, other.componentReads) ||
+                   Overlaps(componentReads, other.componentWrites) ||
+                   Overlaps(resourceWrites, other.resourceWrites) ||
+                   Overlaps(resourceWrites, other.resourceReads) ||
+                   Overlaps(resourceReads, other.resourceWrites);
+        }
+
+    private:
+        template <typename Id>
+        static auto Overlaps(const std::vector<Id>& a, const std::vector<Id>& b) -> bool
+        {
+            for (const Id& id : a)
+            {
+                if (std::find(b.begin(), b.end(), id) != b.end())
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    /**
+     * @brief Per-system data kept across runs.
+     *
+     * ticks.lastRun is the tick of the previous run, so Added and Changed
+     * terms see everything that happened since then. Parameters that resolve
+     * storage once, like PoolHandle, bind it here while the system is built.
+     */
+    struct SystemState
+    {
+        TickRange ticks;
+        std::vector<Container::ISparseSet*> pools; ///< Bound pools, indexed by component index
+
+        auto Bind(std::uint32_t component, Container::ISparseSet* pool) -> void
+        {
+            if (component >= pools.size())
+            {
+                pools.resize(component + 1, nullptr);
+            }
+            pools[component] = pool;
+        }
+
+        auto Bound(std::uint32_t component) const -> Container::ISparseSet*
+        {
+            assert(component < pools.size() && pools[component] && "Pool wasn't bound while declaring the system");
+            return pools[component];
+        }
+    };
+
     struct SystemEntry
     {
         void (*invoke)(void*, World&);
@@ -27,6 +120,19 @@ namespace FECS::Internal
         float accumulator = 0.0f;
     };
 
+    /**
+     * @brief Dependency DAG over the systems of one (set, mode) pair.
+     *
+     * Node indices match the position of the system in its baked vector, so
+     * the sequential order is always a valid topological order of the graph.
+     */
+    struct SystemGraph
+    {
+        std::vector<std::vector<std::uint32_t>> successors;
+        std::vector<std::uint32_t> dependencyCounts;
+        std::vector<bool> exclusive;
+    };
+
     struct SystemSet
     {
         std::vector<SystemEntry> startupSystem;
@@ -34,6 +140,9 @@ namespace FECS::Internal
         std::vector<SystemEntry> updateSystem;
         std::vector<SystemEntry> fixedSystem;
         std::vector<TimedSystem> timedSystems;
+
+        SystemGraph updateGraph;
+        SystemGraph fixedGraph;
     };
 
     struct StagedSystem
@@ -46,5 +155,7 @@ namespace FECS::Internal
         std::string name;
         std::vector<std::string> after;
         std::vector<std::string> before;
+
+        Internal::SystemAccess access;
     };
 }
@@ -1,15 +1,30 @@
+#pragma once
+#include <type_traits>
 #include "FECS/World.h"
 #include "FECS/Builder/QueryBuilder.h"
+#include "FECS/Internal/SystemData.h"
 
 namespace FECS::Internal
 {
+    /**
+     * @brief Maps a system parameter type to the value passed on invocation.
+     *
+     * Get receives the per-system state, whose ticks scope change detection.
+     * Each specialization also declares the data the parameter touches, which
+     * the scheduler uses to decide which systems may run concurrently.
+     */
     template <typename T>
     struct Resolver;
 
     template <typename T>
     struct Resolver<T&>
     {
-        static auto Get(World& w) -> T&
+        static auto Declare(World&, SystemAccess& access, SystemState&) -> void
+        {
+            access.resourceWrites.push_back(TYPE_ID<T>);
+        }
+
+        static auto Get(World& w, SystemState&) -> T&
         {
             return w.Resources().Get<T>();
         }
@@ -18,7 +33,12 @@ namespace FECS::Internal
     template <typename T>
     struct Resolver<const T&>
     {
-        static auto Get(World& w) -> const T&
+        static auto Declare(World&, SystemAccess& access, SystemState&) -> void
+        {
+            access.resourceReads.push_back(TYPE_ID<T>);
+        }
+
+        static auto Get(World& w, SystemState&) -> const T&
         {
             return w.Resources().Get<T>();
         }
@@ -27,7 +47,12 @@ namespace FECS::Internal
     template <>
     struct Resolver<World&>
     {
-        static auto Get(World& w) -> World&
+        static auto Declare(World&, SystemAccess& access, SystemState&) -> void
+        {
+            access.exclusive = true;
+        }
+
+        static auto Get(World& w, SystemState&) -> World&
         {
             return w;
         }
@@ -36,18 +61,103 @@ namespace FECS::Internal
     template <>
     struct Resolver<const World&>
     {
-        static auto Get(World& w) -> const World&
+        static auto Declare(World&, SystemAccess& access, SystemState&) -> void
+        {
+            access.exclusive = true;
+        }
+
+        static auto Get(World& w, SystemState&) -> const World&
         {
             return w;
         }
     };
 
+    template <>
+    struct Resolver<Manager::JobManager&>
+    {
+        static auto Declare(World&, SystemAccess&, SystemState&) -> void
+        {
+            // The job system is thread-safe, sharing it never orders systems
+        }
+
+        static auto Get(World& w, SystemState&) -> Manager::JobManager&
+        {
+            return w.Jobs();
+        }
+    };
+
+    template <>
+    struct Resolver<Manager::SystemCommands&>
+    {
+        static auto Declare(World&, SystemAccess&, SystemState&) -> void
+        {
+            // Commands are deferred to the next sync point, recording never conflicts
+        }
+
+        static auto Get(World& w, SystemState&) -> Manager::SystemCommands&
+        {
+            return w.Commands().Recorder();
+        }
+    };
+
+    template <typename T>
+    struct Resolver<Container::PoolHandle<T, false>>
+    {
+        static auto Declare(World& w, SystemAccess& access, SystemState& state) -> void
+        {
+            // The pool is resolved once here, runs only read it back from the state
+            DeclareAccess<T>(w.Components().GetStorages(), access);
+            state.Bind(ComponentId<T>(), w.Components().GetStorages().template GetPool<std::remove_const_t<T>>());
+        }
+
+        static auto Get(World&, SystemState& state) -> Container::PoolHandle<T, false>
+        {
+            return Container::PoolHandle<T, false>(static_cast<Container::SparseSet<std::remove_const_t<T>>*>(state.Bound(ComponentId<T>())));
+        }
+    };
+
     template <typename... Components>
     struct Resolver<Builder::QueryBuilder<Components...>>
     {
-        static auto Get(World& w) -> Builder::QueryBuilder<Components...>
+        static auto Declare(World& w, SystemAccess& access, SystemState&) -> void
+        {
+            // Terms create their pools up front so parallel dispatch never grows the storage registry
+            (QueryTerm<Components>::Declare(w.Components().GetStorages(), access), ...);
+        }
+
+        static auto Get(World& w, SystemState& state) -> Builder::QueryBuilder<Components...>
+        {
+            return w.View().Query<Components...>(state.ticks);
+        }
+    };
+
+    template <typename... Components>
+    struct Resolver<Builder::CachedQuery<Components...>&>
+    {
+        static auto Declare(World& w, SystemAccess& access, SystemState& state) -> void
+        {
+            Resolver<Builder::QueryBuilder<Components...>>::Declare(w, access, state);
+            w.View().Cached<Components...>();
+        }
+
+        static auto Get(World& w, SystemState& state) -> Builder::CachedQuery<Components...>&
+        {
+            return w.View().Cached<Components...>(state.ticks.thisRun);
+        }
+    };
+
+    template <typename... Components>
+    struct Resolver<Builder::GroupBuilder<Components...>>
+    {
+        static auto Declare(World& w, SystemAccess& access, SystemState& state) -> void
+        {
+            Resolver<Builder::QueryBuilder<Components...>>::Declare(w, access, state);
+            w.Components().GetStorages().template GetGroup<std::remove_const_t<Components>...>();
+        }
+
+        static auto Get(World& w, SystemState& state) -> Builder::GroupBuilder<Components...>
         {
-            return w.View().Query<Components...>();
+            return w.View().Group<Components...>(state.ticks.thisRun);
         }
     };
 }
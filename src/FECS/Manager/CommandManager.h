@@ -0,0 +1,234 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "FECS/Containers/CommandBuffer.h"
+#include "FECS/Manager/ComponentManager.h"
+#include "FECS/Manager/EntityManager.h"
+#include "FECS/Manager/JobManager.h"
+
+namespace FECS::Manager
+{
+    class CommandManager;
+
+    /**
+     * @brief The Commands parameter of systems, records into the calling thread's CommandBuffer.
+     *
+     * The buffer is looked up on every call, so a system may record from
+     * inside ParallelEach() and every worker writes into its own buffer. A
+     * PendingEntity is only valid on the thread that created it.
+     */
+    class SystemCommands
+    {
+    public:
+        explicit SystemCommands(CommandManager& manager)
+            : m_Manager(manager)
+        {
+        }
+
+        SystemCommands(const SystemCommands&) = delete;
+        SystemCommands& operator=(const SystemCommands&) = delete;
+
+        auto Create() -> Container::PendingEntity;
+
+        /**
+         * @brief Reserves an entity whose handle is final right away, valid on every thread.
+         *
+         * It becomes alive at the next sync point, see EntityManager::ReserveEntity():
+         * @code
+         * FECS::Entity spawned = commands.Reserve();
+         * commands.Attach(spawned, Position{0.0f, 0.0f});
+         * @endcode
+         */
+        auto Reserve() -> Entity;
+
+        auto Destroy(Entity entity) -> void;
+
+        template <typename T>
+        auto Attach(Entity entity, T&& component) -> void;
+
+        template <typename T>
+        auto Attach(Container::PendingEntity entity, T&& component) -> void;
+
+        template <typename T, typename... Args>
+        auto Emplace(Entity entity, Args&&... args) -> void;
+
+        template <typename T, typename... Args>
+        auto Emplace(Container::PendingEntity entity, Args&&... args) -> void;
+
+        template <typename T>
+        auto Detach(Entity entity) -> void;
+
+        /// @brief The calling thread's buffer, see CommandManager::Local().
+        auto Local() -> Container::CommandBuffer&;
+
+    private:
+        CommandManager& m_Manager;
+    };
+
+    /**
+     * @brief Owns one CommandBuffer per job system thread and plays them back at sync points.
+     *
+     * Local() hands every thread its own buffer, so systems running in parallel
+     * can record without synchronization. The scheduler calls Flush() after
+     * each system set, buffers are played back in thread order.
+     */
+    class CommandManager
+    {
+    public:
+        CommandManager(EntityManager& entities, std::unique_ptr<ComponentManager>& components, JobManager& jobs)
+            : m_EntityManager(entities),
+              p_ComponentManager(components),
+              m_JobManager(jobs),
+              m_Recorder(*this)
+        {
+        }
+
+        CommandManager(const CommandManager&) = delete;
+        CommandManager& operator=(const CommandManager&) = delete;
+
+        /// @brief Returns the calling thread's buffer.
+        auto Local() -> Container::CommandBuffer&
+        {
+            std::size_t index = m_JobManager.CurrentWorkerIndex();
+
+            const Slots* slots = m_Slots.load(std::memory_order_acquire);
+            if (slots && index < slots->buffers.size())
+            {
+                return *slots->buffers[index];
+            }
+
+            return Grow(index);
+        }
+
+        /// @brief Reserves an entity from any thread, it becomes alive at the next Flush().
+        auto ReserveEntity() -> Entity
+        {
+            return m_EntityManager.ReserveEntity();
+        }
+
+        /// @brief Recorder handed to systems, safe to share between threads.
+        auto Recorder() -> SystemCommands&
+        {
+            return m_Recorder;
+        }
+
+        /**
+         * @brief Makes reserved entities alive, then plays back and resets every buffer.
+         *
+         * Must not run concurrently with recording or EntityManager::ReserveEntity().
+         */
+        auto Flush() -> void
+        {
+            m_EntityManager.FlushReserved();
+
+            const Slots* slots = m_Slots.load(std::memory_order_acquire);
+            if (!slots)
+            {
+                return;
+            }
+
+            for (Container::CommandBuffer* buffer : slots->buffers)
+            {
+                buffer->Playback(m_EntityManager.GetStorage(), p_ComponentManager->GetStorages());
+            }
+        }
+
+    private:
+        struct Slots
+        {
+            std::vector<Container::CommandBuffer*> buffers;
+        };
+
+        auto Grow(std::size_t index) -> Container::CommandBuffer&
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            const Slots* current = m_Slots.load(std::memory_order_relaxed);
+            if (current && index < current->buffers.size())
+            {
+                return *current->buffers[index];
+            }
+
+            // Readers may still hold the old table, so it is retired rather than freed
+            auto grown = std::make_unique<Slots>();
+            if (current)
+            {
+                grown->buffers = current->buffers;
+            }
+            while (grown->buffers.size() <= index)
+            {
+                m_Buffers.push_back(std::make_unique<Container::CommandBuffer>());
+                grown->buffers.push_back(m_Buffers.back().get());
+            }
+
+            m_Slots.store(grown.get(), std::memory_order_release);
+            m_Tables.push_back(std::move(grown));
+
+            return *m_Tables.back()->buffers[index];
+        }
+
+        EntityManager& m_EntityManager;
+        std::unique_ptr<ComponentManager>& p_ComponentManager;
+        JobManager& m_JobManager;
+        SystemCommands m_Recorder;
+
+        std::atomic<const Slots*> m_Slots = nullptr;
+        std::vector<std::unique_ptr<Slots>> m_Tables;
+        std::vector<std::unique_ptr<Container::CommandBuffer>> m_Buffers;
+        std::mutex m_Mutex;
+    };
+
+    inline auto SystemCommands::Create() -> Container::PendingEntity
+    {
+        return Local().Create();
+    }
+
+    inline auto SystemCommands::Reserve() -> Entity
+    {
+        return m_Manager.ReserveEntity();
+    }
+
+    inline auto SystemCommands::Destroy(Entity entity) -> void
+    {
+        Local().Destroy(entity);
+    }
+
+    template <typename T>
+    auto SystemCommands::Attach(Entity entity, T&& component) -> void
+    {
+        Local().Attach(entity, std::forward<T>(component));
+    }
+
+    template <typename T>
+    auto SystemCommands::Attach(Container::PendingEntity entity, T&& component) -> void
+    {
+        Local().Attach(entity, std::forward<T>(component));
+    }
+
+    template <typename T, typename... Args>
+    auto SystemCommands::Emplace(Entity entity, Args&&... args) -> void
+    {
+        Local().template Emplace<T>(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T, typename... Args>
+    auto SystemCommands::Emplace(Container::PendingEntity entity, Args&&... args) -> void
+    {
+        Local().template Emplace<T>(entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    auto SystemCommands::Detach(Entity entity) -> void
+    {
+        Local().template Detach<T>(entity);
+    }
+
+    inline auto SystemCommands::Local() -> Container::CommandBuffer&
+    {
+        return m_Manager.Local();
+    }
+}
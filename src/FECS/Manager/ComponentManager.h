@@ -1,6 +1,15 @@
 #pragma once
+#include <cstddef>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "FECS/Containers/ComponentStorage.h"
+#include "FECS/Containers/PoolHandle.h"
 #include "FECS/Containers/SparseSet.h"
+#include "FECS/Core/ComponentTraits.h"
+#include "FECS/Core/SoA.h"
 
 namespace FECS::Manager
 {
@@ -12,50 +21,175 @@ namespace FECS::Manager
         template <typename T>
         auto Attach(Entity entity, const T& component) -> void
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            pool->Insert(entity, component);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                m_ComponentStorage.GetArchetypes().Emplace<T>(entity, component);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                pool->Insert(entity, component);
+            }
         }
 
         template <typename T>
         auto Attach(Entity entity, T&& component) -> void
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            pool->Insert(entity, std::move(component));
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                m_ComponentStorage.GetArchetypes().Emplace<T>(entity, std::move(component));
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                pool->Insert(entity, std::move(component));
+            }
         }
 
         template <typename T, typename... Args>
         auto Emplace(Entity entity, Args&&... args) -> void
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            pool->Emplace(entity, std::forward<Args>(args)...);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                m_ComponentStorage.GetArchetypes().Emplace<T>(entity, std::forward<Args>(args)...);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                pool->Emplace(entity, std::forward<Args>(args)...);
+            }
         }
 
         template <typename T>
         auto Detach(Entity entity) -> void
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            pool->Remove(entity);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                m_ComponentStorage.GetArchetypes().Remove<T>(entity);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                pool->Remove(entity);
+            }
         }
 
+        /// @brief Reference to the component of the entity, a SoARef<T> proxy for SoA components.
         template <typename T>
-        auto Get(Entity entity) -> T&
+        auto Get(Entity entity) -> ComponentRef<T>
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            return pool->Get(entity);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return m_ComponentStorage.GetArchetypes().Get<T>(entity);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                return pool->Get(entity);
+            }
         }
 
         template <typename T>
         auto Has(Entity entity) -> bool
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            return pool->Has(entity);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return m_ComponentStorage.GetArchetypes().Has<T>(entity);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                return pool->Has(entity);
+            }
+        }
+
+        /**
+         * @brief Assigns component indices to Ts in order and creates their storage.
+         *
+         * Called right after constructing the first World, before the
+         * components are used anywhere else, it makes the component indices the
+         * same in every run, see ::ComponentIndex::Register().
+         */
+        template <typename... Ts>
+        auto Register() -> void
+        {
+            ::ComponentIndex::Register<Ts...>();
+            (m_ComponentStorage.Prepare<Ts>(), ...);
+        }
+
+        /**
+         * @brief Resolves the pool of T once, for hot loops calling Get, Has or TryGet many times.
+         *
+         * A const T yields a read-only handle. Table components have no pool.
+         */
+        template <typename T>
+        auto Pool() -> Container::PoolHandle<T>
+        {
+            return Container::PoolHandle<T>(m_ComponentStorage.GetPool<std::remove_const_t<T>>());
+        }
+
+        /**
+         * @brief Attaches Components to entities that have none of them, one pool at a time.
+         *
+         * The k-th source provides the k-th component of entities[i], either as an
+         * indexable range (copied from, or moved from when passed as an rvalue) or
+         * as a generator invoked with i. Table components are appended straight
+         * into the table of their combined signature, so the entities must not
+         * have any table component yet.
+         */
+        template <typename... Components, typename... Sources>
+        auto AttachBatch(std::span<const Entity> entities, Sources&&... sources) -> void
+        {
+            static_assert(sizeof...(Components) == sizeof...(Sources), "AttachBatch needs one source per component");
+
+            (AttachColumn<Components>(entities, std::forward<Sources>(sources)), ...);
+
+            std::vector<std::uint32_t> tableComponents;
+            (RegisterTableColumn<Components>(tableComponents), ...);
+            if (!tableComponents.empty())
+            {
+                Container::ArchetypeStorage::Location first = m_ComponentStorage.GetArchetypes().Append(entities, std::move(tableComponents));
+                (ConstructTableColumn<Components>(first, entities.size(), std::forward<Sources>(sources)), ...);
+            }
+        }
+
+        /**
+         * @brief Whether the entity has every one of Ts.
+         *
+         * Pooled components are tested with a single mask compare against the
+         * entity's signature.
+         */
+        template <typename... Ts>
+        auto HasAll(Entity entity) -> bool
+        {
+            const Container::EntitySignatures::Mask& mask = m_ComponentStorage.MaskOf<Ts...>();
+            return m_ComponentStorage.GetSignatures().HasAll(entity, mask) &&
+                   (InTableOrPooled<Ts>(entity) && ...);
+        }
+
+        /**
+         * @brief Whether the entity has at least one of Ts.
+         */
+        template <typename... Ts>
+        auto HasAny(Entity entity) -> bool
+        {
+            const Container::EntitySignatures::Mask& mask = m_ComponentStorage.MaskOf<Ts...>();
+            return m_ComponentStorage.GetSignatures().HasAny(entity, mask) ||
+                   (InTable<Ts>(entity) || ...);
         }
 
         template <typename T>
         auto Reserve(size_t capacity) -> void
         {
-            Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
-            pool->Reserve(capacity);
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                m_ComponentStorage.GetArchetypes().Reserve(capacity);
+            }
+            else
+            {
+                Container::SparseSet<T>* pool = m_ComponentStorage.GetPool<T>();
+                pool->Reserve(capacity);
+            }
         }
 
         auto DetachAllFromEntity(Entity entity) -> void
@@ -69,6 +203,87 @@ namespace FECS::Manager
         }
 
     private:
+        /// @brief Element i of an AttachBatch() source.
+        template <typename C, typename Source>
+        static auto SourceElement(Source&& source, std::size_t i) -> C
+        {
+            if constexpr (std::is_invocable_v<Source&, std::size_t>)
+            {
+                return source(i);
+            }
+            else if constexpr (std::is_lvalue_reference_v<Source>)
+            {
+                return source[i];
+            }
+            else
+            {
+                return std::move(source[i]);
+            }
+        }
+
+        template <typename C, typename Source>
+        auto AttachColumn(std::span<const Entity> entities, Source&& source) -> void
+        {
+            if constexpr (!IS_TABLE_COMPONENT<C>)
+            {
+                m_ComponentStorage.GetPool<C>()->InsertBatch(entities, [&source](std::size_t i) -> C
+                {
+                    return SourceElement<C>(std::forward<Source>(source), i);
+                });
+            }
+        }
+
+        template <typename C>
+        auto RegisterTableColumn(std::vector<std::uint32_t>& components) -> void
+        {
+            if constexpr (IS_TABLE_COMPONENT<C>)
+            {
+                components.push_back(m_ComponentStorage.GetArchetypes().Register<C>());
+            }
+        }
+
+        template <typename C, typename Source>
+        auto ConstructTableColumn(Container::ArchetypeStorage::Location first, std::size_t count, Source&& source) -> void
+        {
+            if constexpr (IS_TABLE_COMPONENT<C>)
+            {
+                std::uint32_t column = first.table->ColumnOf(::ComponentIndex::GetIndex<C>());
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    new (first.table->At(first.row + static_cast<std::uint32_t>(i), column)) C(SourceElement<C>(std::forward<Source>(source), i));
+                }
+            }
+        }
+
+    private:
+        /// @brief Table part of HasAny(), pooled components are answered by the mask.
+        template <typename T>
+        auto InTable(Entity entity) -> bool
+        {
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return m_ComponentStorage.GetArchetypes().Has<T>(entity);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        /// @brief Table part of HasAll(), pooled components are answered by the mask.
+        template <typename T>
+        auto InTableOrPooled(Entity entity) -> bool
+        {
+            if constexpr (IS_TABLE_COMPONENT<T>)
+            {
+                return m_ComponentStorage.GetArchetypes().Has<T>(entity);
+            }
+            else
+            {
+                return true;
+            }
+        }
+
         Container::ComponentStorage m_ComponentStorage;
     };
 }
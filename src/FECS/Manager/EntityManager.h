@@ -1,7 +1,12 @@
 #pragma once
 #include <memory>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
 #include "FECS/Core/Types.h"
 #include "FECS/Builder/EntityBuilder.h"
+#include "FECS/Builder/QueryBuilder.h"
 #include "FECS/Manager/ComponentManager.h"
 #include "FECS/Containers/EntityStorage.h"
 
@@ -21,24 +26,155 @@ namespace FECS::Manager
             return Builder::EntityBuilder(id, p_ComponentManager);
         }
 
+        /**
+         * @brief Creates count entities without components at once.
+         */
+        auto CreateMany(std::size_t count) -> std::vector<Entity>
+        {
+            std::vector<Entity> ids;
+            m_EntityStorage.CreateMany(count, ids);
+            return ids;
+        }
+
+        /**
+         * @brief Creates count entities in consecutive fresh slots, without components.
+         *
+         * Nothing is allocated per entity, the range computes its entities from
+         * their indices. Free slots of destroyed entities aren't reused.
+         */
+        auto CreateRange(std::size_t count) -> Container::EntityStorage::Range
+        {
+            return m_EntityStorage.CreateRange(count);
+        }
+
+        /**
+         * @brief Reserves an entity from any thread, e.g. inside ParallelEach() or a parallel system.
+         *
+         * The entity becomes alive at the next sync point, when the scheduler
+         * flushes the commands, or at FlushReserved(). Its components are
+         * attached through the thread's CommandBuffer:
+         * @code
+         * FECS::Entity spawned = world.Entities().ReserveEntity();
+         * commands.Attach(spawned, Position{0.0f, 0.0f});
+         * @endcode
+         */
+        auto ReserveEntity() -> Entity
+        {
+            return m_EntityStorage.ReserveEntity();
+        }
+
+        /// @brief Makes every reserved entity alive. Must not run concurrently with ReserveEntity().
+        auto FlushReserved() -> void
+        {
+            m_EntityStorage.FlushReserved();
+        }
+
+        /**
+         * @brief Creates count entities and fills their components column by column.
+         *
+         * Each source provides one of Components, see ComponentManager::AttachBatch():
+         * @code
+         * world.Entities().Spawn<Position, Velocity>(1000, positions, [](std::size_t i)
+         * {
+         *     return Velocity{1.0f, 0.0f};
+         * });
+         * @endcode
+         */
+        template <typename... Components, typename... Sources>
+        auto Spawn(std::size_t count, Sources&&... sources) -> std::vector<Entity>
+        {
+            std::vector<Entity> ids = CreateMany(count);
+            p_ComponentManager->AttachBatch<Components...>(ids, std::forward<Sources>(sources)...);
+            return ids;
+        }
+
+        /**
+         * @brief Creates count copies of the prototype entity, copying its components pool by pool.
+         */
+        auto Instantiate(Entity prototype, std::size_t count) -> std::vector<Entity>
+        {
+            std::vector<Entity> ids = CreateMany(count);
+            p_ComponentManager->GetStorages().Instantiate(prototype, ids);
+            return ids;
+        }
+
         auto Modify(Entity id) -> Builder::EntityBuilder
         {
             return Builder::EntityBuilder(id, p_ComponentManager);
         }
 
+        /// @brief Deletes an entity and its components, stale handles are ignored.
         auto Delete(Entity id) -> void
         {
+            if (!m_EntityStorage.IsAlive(id))
+            {
+                return;
+            }
+
             m_EntityStorage.Destroy(id);
             p_ComponentManager->DetachAllFromEntity(id);
         }
 
+        /**
+         * @brief Deletes several entities, removing their components pool by pool.
+         *
+         * Dead and duplicate entities are skipped.
+         */
+        auto DestroyBatch(std::span<const Entity> ids) -> void
+        {
+            m_Batch.clear();
+            m_EntityStorage.DestroyBatch(ids, m_Batch);
+            p_ComponentManager->GetStorages().DeleteEntities(m_Batch);
+        }
+
+        /**
+         * @brief Deletes every entity matched by the query.
+         */
+        template <typename... Components>
+        auto DestroyAll(Builder::QueryBuilder<Components...> query) -> void
+        {
+            std::vector<Entity> matches;
+            query.Each([&matches](Entity id, auto&&...)
+            {
+                matches.push_back(id);
+            });
+            DestroyBatch(matches);
+        }
+
         auto Reserve(size_t capacity) -> void
         {
             m_EntityStorage.Reserve(capacity);
         }
 
+        auto IsAlive(Entity id) const -> bool
+        {
+            return m_EntityStorage.IsAlive(id);
+        }
+
+        auto AliveCount() const -> std::size_t
+        {
+            return m_EntityStorage.AliveCount();
+        }
+
+        /**
+         * @brief Calls func(Entity) for every alive entity, in index order.
+         *
+         * func must not create or delete entities, use the CommandManager for that.
+         */
+        template <typename Func>
+        auto EachAlive(Func&& func) const -> void
+        {
+            m_EntityStorage.EachAlive(std::forward<Func>(func));
+        }
+
+        auto GetStorage() -> Container::EntityStorage&
+        {
+            return m_EntityStorage;
+        }
+
     private:
         std::unique_ptr<ComponentManager>& p_ComponentManager;
         Container::EntityStorage m_EntityStorage;
+        std::vector<Entity> m_Batch;
     };
 }
@@ -0,0 +1,410 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "FECS/Containers/WorkStealingDeque.h"
+
+namespace FECS::Manager
+{
+    /**
+     * @brief Fork/join handle tracking a group of submitted jobs.
+     *
+     * Jobs may keep adding work to the handle they were submitted with, the
+     * handle is only done once every job in the group has finished.
+     */
+    class JobHandle
+    {
+    public:
+        JobHandle()
+            : m_State(std::make_shared<State>())
+        {
+        }
+
+        auto IsDone() const -> bool
+        {
+            return m_State->pending.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+        friend class JobManager;
+
+        struct State
+        {
+            std::atomic<std::uint32_t> pending = 0;
+            std::mutex mutex;
+            std::exception_ptr error;
+        };
+
+        std::shared_ptr<State> m_State;
+    };
+
+    /**
+     * @brief Work-stealing job system shared by everything running on a World.
+     *
+     * Every worker owns a lock-free deque: jobs submitted from a worker are
+     * pushed to its own deque, jobs submitted from other threads go through a
+     * shared injection queue. Idle workers steal from each other before going
+     * to sleep. Threads waiting on a handle execute jobs instead of blocking,
+     * so nested fork/join never deadlocks. Workers are spawned on first use.
+     */
+    class JobManager
+    {
+    public:
+        JobManager() = default;
+        JobManager(const JobManager&) = delete;
+        JobManager& operator=(const JobManager&) = delete;
+
+        ~JobManager()
+        {
+            Stop();
+        }
+
+        /**
+         * @brief Sets the number of worker threads, restarting the workers if running.
+         * @param count Number of workers, 0 selects the hardware concurrency minus the caller.
+         */
+        auto SetWorkerCount(std::size_t count) -> void
+        {
+            Stop();
+            m_RequestedWorkers = count;
+        }
+
+        auto WorkerCount() -> std::size_t
+        {
+            EnsureStarted();
+            return m_Workers.size();
+        }
+
+        /**
+         * @brief Index of the calling thread, 0 for threads that aren't workers of this manager.
+         *
+         * Values range over [0, WorkerCount()] and can be used to address per-thread data.
+         */
+        auto CurrentWorkerIndex() const -> std::size_t
+        {
+            return t_Owner == this ? t_WorkerIndex : 0;
+        }
+
+        template <typename Func>
+        auto Submit(Func&& func) -> JobHandle
+        {
+            JobHandle handle;
+            Submit(handle, std::forward<Func>(func));
+            return handle;
+        }
+
+        template <typename Func>
+        auto Submit(JobHandle& handle, Func&& func) -> void
+        {
+            EnsureStarted();
+
+            handle.m_State->pending.fetch_add(1, std::memory_order_relaxed);
+            Job* job = new Job{std::function<void()>(std::forward<Func>(func)), handle.m_State};
+            Enqueue(&job, 1);
+        }
+
+        /**
+         * @brief Blocks until every job of the handle finished, executing jobs in the meantime.
+         *
+         * Rethrows the first exception thrown by a job of the group.
+         */
+        auto Wait(const JobHandle& handle) -> void
+        {
+            while (!handle.IsDone())
+            {
+                if (Job* job = FindJob(CurrentWorkerIndex()))
+                {
+                    Execute(job);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(handle.m_State->mutex);
+            if (handle.m_State->error)
+            {
+                std::exception_ptr error = handle.m_State->error;
+                handle.m_State->error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * @brief Splits [0, count) into chunks of grainSize and runs func(begin, end) on each.
+         *
+         * The calling thread takes part in the work and returns once every chunk is done.
+         */
+        template <typename Func>
+        auto ParallelFor(std::size_t count, std::size_t grainSize, Func&& func) -> void
+        {
+            grainSize = std::max<std::size_t>(grainSize, 1);
+            if (count <= grainSize)
+            {
+                if (count > 0)
+                {
+                    func(std::size_t(0), count);
+                }
+                return;
+            }
+
+            EnsureStarted();
+
+            JobHandle handle;
+            std::vector<Job*> jobs;
+            jobs.reserve(count / grainSize);
+            for (std::size_t begin = grainSize; begin < count; begin += grainSize)
+            {
+                std::size_t end = std::min(begin + grainSize, count);
+                jobs.push_back(new Job{[&func, begin, end]()
+                {
+                    func(begin, end);
+                }, handle.m_State});
+            }
+
+            handle.m_State->pending.fetch_add(static_cast<std::uint32_t>(jobs.size()), std::memory_order_relaxed);
+            Enqueue(jobs.data(), jobs.size());
+
+            // The first chunk runs on the caller while the workers pick up the rest
+            std::exception_ptr error;
+            try
+            {
+                func(std::size_t(0), grainSize);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            Wait(handle);
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /**
+         * @brief Runs the queued jobs to completion and joins the workers.
+         *
+         * The next Submit() or ParallelFor() starts them again.
+         */
+        auto Stop() -> void
+        {
+            std::lock_guard<std::mutex> startLock(m_StartMutex);
+            if (!m_Started.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_SleepMutex);
+                m_Stopping = true;
+            }
+            m_Wake.notify_all();
+
+            for (auto& worker : m_Workers)
+            {
+                worker->thread.join();
+            }
+
+            m_Workers.clear();
+            m_Started.store(false, std::memory_order_release);
+        }
+
+    private:
+        struct Job
+        {
+            std::function<void()> task;
+            std::shared_ptr<JobHandle::State> state;
+        };
+
+        struct Worker
+        {
+            Container::WorkStealingDeque<Job> deque;
+            std::thread thread;
+        };
+
+        auto EnsureStarted() -> void
+        {
+            if (m_Started.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_StartMutex);
+            if (m_Started.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            std::size_t count = m_RequestedWorkers;
+            if (count == 0)
+            {
+                std::size_t hardware = std::thread::hardware_concurrency();
+                count = hardware > 1 ? hardware - 1 : 1;
+            }
+
+            m_Stopping = false;
+            m_Workers.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                m_Workers.push_back(std::make_unique<Worker>());
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                m_Workers[i]->thread = std::thread([this, i]()
+                {
+                    WorkerLoop(i + 1);
+                });
+            }
+
+            m_Started.store(true, std::memory_order_release);
+        }
+
+        auto Enqueue(Job* const* jobs, std::size_t count) -> void
+        {
+            std::size_t index = CurrentWorkerIndex();
+            if (index > 0)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    m_Workers[index - 1]->deque.Push(jobs[i]);
+                }
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(m_InjectMutex);
+                m_Injected.insert(m_Injected.end(), jobs, jobs + count);
+            }
+
+            m_Queued.fetch_add(static_cast<std::int64_t>(count), std::memory_order_seq_cst);
+            if (m_Sleeping.load(std::memory_order_seq_cst) > 0)
+            {
+                std::lock_guard<std::mutex> lock(m_SleepMutex);
+                if (count > 1)
+                {
+                    m_Wake.notify_all();
+                }
+                else
+                {
+                    m_Wake.notify_one();
+                }
+            }
+        }
+
+        auto FindJob(std::size_t index) -> Job*
+        {
+            Job* job = nullptr;
+
+            if (index > 0)
+            {
+                job = m_Workers[index - 1]->deque.Pop();
+            }
+
+            if (!job)
+            {
+                std::lock_guard<std::mutex> lock(m_InjectMutex);
+                if (!m_Injected.empty())
+                {
+                    job = m_Injected.front();
+                    m_Injected.pop_front();
+                }
+            }
+
+            // Steal starting after ourselves so victims are spread across workers
+            for (std::size_t i = 0; !job && i < m_Workers.size(); ++i)
+            {
+                std::size_t victim = (index + i) % m_Workers.size();
+                if (victim + 1 != index)
+                {
+                    job = m_Workers[victim]->deque.Steal();
+                }
+            }
+
+            if (job)
+            {
+                m_Queued.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            return job;
+        }
+
+        auto Execute(Job* job) -> void
+        {
+            try
+            {
+                job->task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job->state->mutex);
+                if (!job->state->error)
+                {
+                    job->state->error = std::current_exception();
+                }
+            }
+
+            job->state->pending.fetch_sub(1, std::memory_order_release);
+            delete job;
+        }
+
+        auto WorkerLoop(std::size_t index) -> void
+        {
+            t_Owner = this;
+            t_WorkerIndex = index;
+
+            while (true)
+            {
+                if (Job* job = FindJob(index))
+                {
+                    Execute(job);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_SleepMutex);
+                if (m_Stopping)
+                {
+                    break;
+                }
+
+                m_Sleeping.fetch_add(1, std::memory_order_seq_cst);
+                m_Wake.wait(lock, [this]()
+                {
+                    return m_Stopping || m_Queued.load(std::memory_order_seq_cst) > 0;
+                });
+                m_Sleeping.fetch_sub(1, std::memory_order_seq_cst);
+            }
+
+            t_Owner = nullptr;
+            t_WorkerIndex = 0;
+        }
+
+        static inline thread_local const JobManager* t_Owner = nullptr;
+        static inline thread_local std::size_t t_WorkerIndex = 0;
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::size_t m_RequestedWorkers = 0;
+        std::atomic<bool> m_Started = false;
+        std::mutex m_StartMutex;
+
+        std::deque<Job*> m_Injected;
+        std::mutex m_InjectMutex;
+
+        std::atomic<std::int64_t> m_Queued = 0;
+        std::atomic<std::int32_t> m_Sleeping = 0;
+        std::mutex m_SleepMutex;
+        std::condition_variable m_Wake;
+        bool m_Stopping = false;
+    };
+}
@@ -3,23 +3,13 @@
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
-
-class ResourceIndex
-{
-public:
-    template <typename T>
-    static auto GetIndex() -> std::uint32_t
-    {
-        static const std::uint32_t idx = m_Index++;
-        return idx;
-    }
-
-private:
-    static inline std::uint32_t m_Index = 0;
-};
+#include "FECS/Core/TypeId.h"
 
 namespace FECS::Manager
 {
+    /**
+     * @brief Holds one instance per resource type, keyed by its TypeId.
+     */
     class ResourceManager
     {
     public:
@@ -30,7 +20,7 @@ namespace FECS::Manager
         template <typename T, typename... Args>
         auto Emplace(Args&&... args) -> T&
         {
-            const auto typeId = ResourceIndex::GetIndex<T>();
+            constexpr TypeId typeId = TYPE_ID<T>;
 
             std::shared_ptr<T> resource = std::make_shared<T>(std::forward<Args>(args)...);
 
@@ -48,14 +38,14 @@ namespace FECS::Manager
         template <typename T>
         auto Has() const -> bool
         {
-            const auto typeId = ResourceIndex::GetIndex<T>();
+            constexpr TypeId typeId = TYPE_ID<T>;
             return m_Resources.find(typeId) != m_Resources.end();
         }
 
         template <typename T>
         auto Get() -> T&
         {
-            const auto typeId = ResourceIndex::GetIndex<T>();
+            constexpr TypeId typeId = TYPE_ID<T>;
             auto it = m_Resources.find(typeId);
 
             if (it == m_Resources.end())
@@ -67,6 +57,6 @@ namespace FECS::Manager
         }
 
     private:
-        std::unordered_map<std::uint32_t, std::shared_ptr<void>> m_Resources;
+        std::unordered_map<TypeId, std::shared_ptr<void>> m_Resources;
     };
 }
@@ -3,8 +3,11 @@
 #include "FECS/Internal/SystemData.h"
 #include "FECS/World.h"
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <exception>
 #include <map>
+#include <memory>
 #include <queue>
 #include <sstream>
 #include <stdexcept>
@@ -24,19 +27,9 @@ namespace FECS::Manager {
 
         ~ScheduleManager()
         {
-            for (auto &set : m_Sets) {
-                for (auto &sys : set.startupSystem) {
-                    sys.destroy(sys.object);
-                }
-                for (auto &sys : set.updateSystem) {
-                    sys.destroy(sys.object);
-                }
-                for (auto &sys : set.fixedSystem) {
-                    sys.destroy(sys.object);
-                }
-                for (auto &sys : set.timedSystems) {
-                    sys.func.destroy(sys.func.object);
-                }
+            // Staged entries own every system that hasn't been consumed by RunStartup/RunCleanUp
+            for (auto &stage : m_Staged) {
+                stage.entry.destroy(stage.entry.object);
             }
         }
 
@@ -45,6 +38,24 @@ namespace FECS::Manager {
             m_SetExecutionOrder = order;
         }
 
+        /**
+         * @brief Selects how Update and Fixed systems are dispatched.
+         *
+         * In PARALLEL mode systems of the same set run concurrently on the World's
+         * job system unless their declared accesses conflict or an After/Before edge
+         * orders them. Sets still act as barriers. SEQUENTIAL (the default) keeps
+         * the deterministic single-threaded order, which is useful for debugging.
+         */
+        auto SetExecutionMode(Internal::ExecutionMode mode) -> void
+        {
+            m_ExecutionMode = mode;
+        }
+
+        auto GetExecutionMode() const -> Internal::ExecutionMode
+        {
+            return m_ExecutionMode;
+        }
+
         auto AddSystem() -> Builder::SystemBuilder<>
         {
             return Builder::SystemBuilder<>(m_World, *this);
@@ -52,6 +63,8 @@ namespace FECS::Manager {
 
         auto Run(float dt) -> void
         {
+            Bake();
+
             m_GlobalFixedAccumulator += dt;
 
             if (m_FixedStep > 0.0f)
@@ -61,9 +74,9 @@ namespace FECS::Manager {
                     for (const auto &setIndex : m_SetExecutionOrder) {
                         if (setIndex < m_Sets.size())
                         {
-                            for (auto &sys : m_Sets[setIndex].fixedSystem) {
-                                sys.invoke(sys.object, m_World);
-                            }
+                            Internal::SystemSet &set = m_Sets[setIndex];
+                            RunGraph(set.fixedSystem, set.fixedGraph);
+                            m_World.Commands().Flush();
                         }
                     }
                     m_GlobalFixedAccumulator -= m_FixedStep;
@@ -78,9 +91,7 @@ namespace FECS::Manager {
 
                 Internal::SystemSet &set = m_Sets[setIndex];
 
-                for (auto &sys : set.updateSystem) {
-                    sys.invoke(sys.object, m_World);
-                }
+                RunGraph(set.updateSystem, set.updateGraph);
 
                 for (auto &sys : set.timedSystems) {
                     sys.accumulator += dt;
@@ -90,11 +101,16 @@ namespace FECS::Manager {
                         sys.accumulator -= sys.interval;
                     }
                 }
+
+                // Sets are sync points, deferred structural changes land before the next one runs
+                m_World.Commands().Flush();
             }
         }
 
         auto RunStartup() -> void
         {
+            Bake();
+
             for (const auto &setIndex : m_SetExecutionOrder) {
                 if (setIndex >= m_Sets.size())
                 {
@@ -109,11 +125,16 @@ namespace FECS::Manager {
                 }
 
                 set.startupSystem.clear();
+                m_World.Commands().Flush();
             }
+
+            ReleaseStaged(Internal::SystemMode::STARTUP);
         }
 
         auto RunCleanUp() -> void
         {
+            Bake();
+
             for (const auto &setIndex : m_SetExecutionOrder) {
                 if (setIndex >= m_Sets.size())
                 {
@@ -128,7 +149,10 @@ namespace FECS::Manager {
                 }
 
                 set.cleanupSystem.clear();
+                m_World.Commands().Flush();
             }
+
+            ReleaseStaged(Internal::SystemMode::CLEANUP);
         }
 
         template <typename Func>
@@ -138,7 +162,8 @@ namespace FECS::Manager {
             float interval,
             const std::string &name,
             std::vector<std::string> afterSystems,
-            std::vector<std::string> beforeSystems) -> void
+            std::vector<std::string> beforeSystems,
+            Internal::SystemAccess access) -> void
         {
             if (setIndex >= m_Sets.size())
             {
@@ -168,7 +193,8 @@ namespace FECS::Manager {
                 interval,
                 name,
                 std::move(afterSystems),
-                std::move(beforeSystems)
+                std::move(beforeSystems),
+                std::move(access)
             });
 
             m_Baked = false;
@@ -184,13 +210,16 @@ namespace FECS::Manager {
             if (m_Baked)
                 return;
 
-            // 1. Clear existing sets to rebuild them
+            // 1. Clear existing sets to rebuild them from every staged system
             for(auto& set : m_Sets)
             {
                 set.startupSystem.clear();
+                set.cleanupSystem.clear();
                 set.updateSystem.clear();
                 set.fixedSystem.clear();
                 set.timedSystems.clear();
+                set.updateGraph = {};
+                set.fixedGraph = {};
             }
 
             // 2. Group staged systems by (SetIndex, Mode)
@@ -237,14 +266,186 @@ namespace FECS::Manager {
                         break;
                     }
                 }
+
+                // 4. Derive the dependency graph used for parallel dispatch
+                if (key.mode == Internal::SystemMode::UPDATE)
+                {
+                    targetSet.updateGraph = BuildGraph(sortedIndices);
+                }
+                else if (key.mode == Internal::SystemMode::FIXED)
+                {
+                    targetSet.fixedGraph = BuildGraph(sortedIndices);
+                }
             }
 
-            // Clear staged now that ownership is transferred to m_Sets
-            m_Staged.clear();
+            // Staged systems keep ownership, so a later Bake can re-sort them with new additions
             m_Baked = true;
         }
 
     private:
+        /// @brief Shared state of one parallel graph execution, kept alive by every in-flight job.
+        struct GraphRun
+        {
+            std::vector<Internal::SystemEntry>* systems;
+            const Internal::SystemGraph* graph;
+            std::unique_ptr<std::atomic<std::uint32_t>[]> pending;
+            std::atomic<bool> failed = false;
+            JobHandle handle;
+        };
+
+        auto RunGraph(std::vector<Internal::SystemEntry>& systems, const Internal::SystemGraph& graph) -> void
+        {
+            if (m_ExecutionMode == Internal::ExecutionMode::SEQUENTIAL || systems.size() < 2)
+            {
+                for (auto &sys : systems) {
+                    sys.invoke(sys.object, m_World);
+                }
+                return;
+            }
+
+            auto run = std::make_shared<GraphRun>();
+            run->systems = &systems;
+            run->graph = &graph;
+            run->pending.reset(new std::atomic<std::uint32_t>[systems.size()]);
+            for (std::size_t i = 0; i < systems.size(); ++i)
+            {
+                run->pending[i].store(graph.dependencyCounts[i], std::memory_order_relaxed);
+            }
+
+            for (std::uint32_t i = 0; i < systems.size(); ++i)
+            {
+                if (graph.dependencyCounts[i] == 0)
+                {
+                    Dispatch(run, i);
+                }
+            }
+
+            // Successors join the same handle before their predecessor completes, so this covers the whole graph
+            m_World.Jobs().Wait(run->handle);
+        }
+
+        auto Dispatch(const std::shared_ptr<GraphRun>& run, std::uint32_t node) -> void
+        {
+            m_World.Jobs().Submit(run->handle, [this, run, node]()
+            {
+                // Once a system has thrown, the rest of the graph is drained without running
+                if (!run->failed.load(std::memory_order_acquire))
+                {
+                    // Debug builds assert that systems sharing the dispatch make no structural changes
+                    bool shared = !run->graph->exclusive[node];
+                    Container::EntitySignatures& signatures = m_World.Components().GetStorages().GetSignatures();
+                    if (shared)
+                    {
+                        signatures.EnterParallel();
+                    }
+
+                    try
+                    {
+                        Internal::SystemEntry& sys = (*run->systems)[node];
+                        sys.invoke(sys.object, m_World);
+                    }
+                    catch (...)
+                    {
+                        if (shared)
+                        {
+                            signatures.LeaveParallel();
+                        }
+                        run->failed.store(true, std::memory_order_release);
+                        ReleaseSuccessors(run, node);
+                        throw;
+                    }
+
+                    if (shared)
+                    {
+                        signatures.LeaveParallel();
+                    }
+                }
+
+                ReleaseSuccessors(run, node);
+            });
+        }
+
+        auto ReleaseSuccessors(const std::shared_ptr<GraphRun>& run, std::uint32_t node) -> void
+        {
+            for (std::uint32_t next : run->graph->successors[node])
+            {
+                if (run->pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    Dispatch(run, next);
+                }
+            }
+        }
+
+        auto BuildGraph(const std::vector<size_t>& sortedIndices) -> Internal::SystemGraph
+        {
+            Internal::SystemGraph graph;
+            graph.successors.resize(sortedIndices.size());
+            graph.dependencyCounts.assign(sortedIndices.size(), 0);
+            graph.exclusive.resize(sortedIndices.size());
+
+            std::unordered_map<std::string, std::uint32_t> nameToNode;
+            for (std::uint32_t node = 0; node < sortedIndices.size(); ++node)
+            {
+                const auto& sys = m_Staged[sortedIndices[node]];
+                if (!sys.name.empty())
+                {
+                    nameToNode[sys.name] = node;
+                }
+            }
+
+            auto addEdge = [&graph](std::uint32_t from, std::uint32_t to)
+            {
+                auto& successors = graph.successors[from];
+                if (from != to && std::find(successors.begin(), successors.end(), to) == successors.end())
+                {
+                    successors.push_back(to);
+                    graph.dependencyCounts[to]++;
+                }
+            };
+
+            // Edges always point forward in the sorted order, so the sequential order stays valid
+            for (std::uint32_t node = 0; node < sortedIndices.size(); ++node)
+            {
+                const auto& sys = m_Staged[sortedIndices[node]];
+                graph.exclusive[node] = sys.access.exclusive;
+
+                for (const auto& targetName : sys.after)
+                {
+                    if (auto it = nameToNode.find(targetName); it != nameToNode.end())
+                    {
+                        addEdge(it->second, node);
+                    }
+                }
+
+                for (const auto& targetName : sys.before)
+                {
+                    if (auto it = nameToNode.find(targetName); it != nameToNode.end())
+                    {
+                        addEdge(node, it->second);
+                    }
+                }
+
+                for (std::uint32_t prev = 0; prev < node; ++prev)
+                {
+                    if (m_Staged[sortedIndices[prev]].access.ConflictsWith(sys.access))
+                    {
+                        addEdge(prev, node);
+                    }
+                }
+            }
+
+            return graph;
+        }
+
+        auto ReleaseStaged(Internal::SystemMode mode) -> void
+        {
+            // The entries were destroyed after running, drop them so they aren't baked again
+            m_Staged.erase(std::remove_if(m_Staged.begin(), m_Staged.end(), [mode](const Internal::StagedSystem& stage)
+            {
+                return stage.mode == mode;
+            }), m_Staged.end());
+        }
+
         auto TopologicalSort(const std::vector<size_t>& subsetIndices) -> std::vector<size_t>
         {
             if (subsetIndices.empty())
@@ -351,6 +552,8 @@ namespace FECS::Manager {
         float m_GlobalFixedAccumulator = 0.0f;
         bool m_Baked = false;
 
+        Internal::ExecutionMode m_ExecutionMode = Internal::ExecutionMode::SEQUENTIAL;
+
         std::vector<Internal::SystemSet> m_Sets;
         std::vector<Internal::StagedSystem> m_Staged;
         std::vector<uint16_t> m_SetExecutionOrder;
@@ -360,9 +563,9 @@ namespace FECS::Manager {
 namespace FECS::Builder {
     template <typename ... Args>
     template <typename Func>
-    auto SystemBuilder<Args...>::RegisterToScheduler(Func &&func) -> void
+    auto SystemBuilder<Args...>::RegisterToScheduler(Func &&func, Internal::SystemAccess access) -> void
     {
         m_ScheduleManager.RegisterSystem(func, m_SetIndex, m_Mode, m_Interval, m_Name,
-            m_After, m_Before);
+            m_After, m_Before, std::move(access));
     }
 }
@@ -1,14 +1,22 @@
 #pragma once
+#include "FECS/Builder/CachedQuery.h"
+#include "FECS/Builder/GroupBuilder.h"
 #include "FECS/Builder/QueryBuilder.h"
+#include "FECS/Manager/JobManager.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace FECS::Manager
 {
     class ViewManager
     {
     public:
-        ViewManager(std::unique_ptr<ComponentManager>& manager)
-            : p_ComponentManager(manager.get())
+        ViewManager(std::unique_ptr<ComponentManager>& manager, JobManager& jobs)
+            : p_ComponentManager(manager.get()),
+              p_JobManager(&jobs)
         {
         }
 
@@ -17,10 +25,74 @@ namespace FECS::Manager
         template <typename... Components>
         auto Query() -> Builder::QueryBuilder<Components...>
         {
-            return Builder::QueryBuilder<Components...>(p_ComponentManager);
+            return Builder::QueryBuilder<Components...>(p_ComponentManager, p_JobManager);
+        }
+
+        /**
+         * @brief Query whose Added and Changed terms compare against ticks.lastRun.
+         */
+        template <typename... Components>
+        auto Query(TickRange ticks) -> Builder::QueryBuilder<Components...>
+        {
+            return Builder::QueryBuilder<Components...>(p_ComponentManager, p_JobManager, ticks);
+        }
+
+        /**
+         * @brief Iterates the owning group of these components, creating the group on first use.
+         *
+         * The group takes over the dense order of the owned pools, see Container::OwningGroup.
+         */
+        template <typename... Components>
+        auto Group() -> Builder::GroupBuilder<Components...>
+        {
+            return Builder::GroupBuilder<Components...>(p_ComponentManager, p_JobManager);
+        }
+
+        template <typename... Components>
+        auto Group(Tick tick) -> Builder::GroupBuilder<Components...>
+        {
+            return Builder::GroupBuilder<Components...>(p_ComponentManager, p_JobManager, tick);
+        }
+
+        /**
+         * @brief Returns the persistent cached query for this component list, creating it on first use.
+         *
+         * The query lives as long as the ViewManager, so the reference can be kept.
+         */
+        template <typename... Components>
+        auto Cached() -> Builder::CachedQuery<Components...>&
+        {
+            return Cached<Components...>(0);
+        }
+
+        /// @param tick Tick mutably accessed tracked components are stamped with, see CachedQuery::SetTick().
+        template <typename... Components>
+        auto Cached(Tick tick) -> Builder::CachedQuery<Components...>&
+        {
+            static const std::uint32_t idx = s_CacheIndex.fetch_add(1, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(m_CacheMutex);
+            if (idx >= m_Cached.size())
+            {
+                m_Cached.resize(idx + 1);
+            }
+
+            if (!m_Cached[idx])
+            {
+                m_Cached[idx] = std::make_unique<Builder::CachedQuery<Components...>>(p_ComponentManager, p_JobManager);
+            }
+
+            auto& query = static_cast<Builder::CachedQuery<Components...>&>(*m_Cached[idx]);
+            query.SetTick(tick);
+            return query;
         }
 
     private:
+        static inline std::atomic<std::uint32_t> s_CacheIndex = 0; ///< Atomic, cached queries may be first used from parallel systems
+
         ComponentManager* p_ComponentManager;
+        JobManager* p_JobManager;
+        std::vector<std::unique_ptr<Builder::ICachedQuery>> m_Cached;
+        std::mutex m_CacheMutex;
     };
 };
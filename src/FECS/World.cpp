@@ -1,7 +1,9 @@
 #include "FECS/World.h"
 #include "FECS/Manager/ScheduleManager.h"
+#include "FECS/Manager/CommandManager.h"
 #include "FECS/Manager/ComponentManager.h"
 #include "FECS/Manager/EntityManager.h"
+#include "FECS/Manager/JobManager.h"
 #include "FECS/Manager/ResourceManager.h"
 #include "FECS/Manager/ViewManager.h"
 
@@ -9,14 +11,20 @@ namespace FECS
 {
     World::World()
     {
+        p_JobManager = std::make_unique<Manager::JobManager>();
         p_ComponentManager = std::make_unique<Manager::ComponentManager>();
         p_EntityManager = std::make_unique<Manager::EntityManager>(p_ComponentManager);
         p_ResourceManager = std::make_unique<Manager::ResourceManager>();
         p_ScheduleManager = std::make_unique<Manager::ScheduleManager>(*this);
-        p_ViewManager = std::make_unique<Manager::ViewManager>(p_ComponentManager);
+        p_ViewManager = std::make_unique<Manager::ViewManager>(p_ComponentManager, *p_JobManager);
+        p_CommandManager = std::make_unique<Manager::CommandManager>(*p_EntityManager, p_ComponentManager, *p_JobManager);
     }
 
-    World::~World() = default;
+    World::~World()
+    {
+        // Queued jobs may still reach into the other managers, finish them before anything is torn down
+        p_JobManager->Stop();
+    }
 
     auto World::Scheduler() -> Manager::ScheduleManager&
     {
@@ -42,4 +50,14 @@ namespace FECS
     {
         return *p_ResourceManager;
     }
+
+    auto World::Jobs() -> Manager::JobManager&
+    {
+        return *p_JobManager;
+    }
+
+    auto World::Commands() -> Manager::CommandManager&
+    {
+        return *p_CommandManager;
+    }
 }
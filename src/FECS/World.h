@@ -1,7 +1,9 @@
 #pragma once
 #include <memory>
+#include "FECS/Manager/CommandManager.h"
 #include "FECS/Manager/EntityManager.h"
 #include "FECS/Manager/ComponentManager.h"
+#include "FECS/Manager/JobManager.h"
 #include "FECS/Manager/ResourceManager.h"
 #include "FECS/Manager/ViewManager.h"
 
@@ -14,6 +16,8 @@ namespace FECS
         class ComponentManager;
         class ResourceManager;
         class ViewManager;
+        class JobManager;
+        class CommandManager;
     }
 
     class World
@@ -27,13 +31,19 @@ namespace FECS
         auto View() -> Manager::ViewManager&;
         auto Resources() -> Manager::ResourceManager&;
         auto Scheduler() -> Manager::ScheduleManager&;
+        auto Jobs() -> Manager::JobManager&;
+        auto Commands() -> Manager::CommandManager&;
 
     private:
         // managers
+        // the job system is declared first so the references other managers hold stay valid until they are gone,
+        // ~World stops its workers before any manager is destroyed
+        std::unique_ptr<Manager::JobManager> p_JobManager;
         std::unique_ptr<Manager::EntityManager> p_EntityManager;
         std::unique_ptr<Manager::ComponentManager> p_ComponentManager;
         std::unique_ptr<Manager::ResourceManager> p_ResourceManager;
         std::unique_ptr<Manager::ScheduleManager> p_ScheduleManager;
         std::unique_ptr<Manager::ViewManager> p_ViewManager;
+        std::unique_ptr<Manager::CommandManager> p_CommandManager;
     };
 }